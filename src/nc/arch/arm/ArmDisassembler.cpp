@@ -26,11 +26,13 @@ ArmDisassembler::ArmDisassembler(const ArmArchitecture *architecture):
 
 ArmDisassembler::~ArmDisassembler() {}
 
-std::shared_ptr<core::arch::Instruction> ArmDisassembler::disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) {
+std::unique_ptr<core::arch::Instruction> ArmDisassembler::disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) {
     if (auto instr = capstone_->disassemble(pc, buffer, size, 1)) {
         /* Instructions must be aligned to their size. */
         if ((instr->address & (instr->size - 1)) == 0) {
-            return std::make_shared<ArmInstruction>(mode_, instr->address, instr->size, buffer);
+            auto result = std::make_unique<ArmInstruction>(mode_, instr->address, instr->size, buffer);
+            result->setDecoded(*instr);
+            return result;
         }
     }
     return nullptr;
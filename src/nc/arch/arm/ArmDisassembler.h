@@ -30,7 +30,7 @@ public:
 
     virtual ~ArmDisassembler();
 
-    std::shared_ptr<core::arch::Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) override;
+    std::unique_ptr<core::arch::Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) override;
 };
 
 }}} // namespace nc::arch::arm
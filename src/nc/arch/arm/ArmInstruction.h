@@ -5,13 +5,232 @@
 
 #include <nc/config.h>
 
+#include <cassert>
+#include <cstdint>
+
+#include <nc/common/Unused.h>
+
 #include <nc/core/arch/CapstoneInstruction.h>
 
 namespace nc {
 namespace arch {
 namespace arm {
 
-typedef core::arch::CapstoneInstruction<CS_ARCH_ARM, 4> ArmInstruction;
+/**
+ * Decoded form of an ARM instruction: the part of Capstone's output
+ * that ArmInstructionAnalyzer works with, packed into 56 bytes.
+ *
+ * Only instructions with at most MAX_OPERANDS operands are kept.
+ * Others, e.g. loads and stores of register lists, are decoded again
+ * by the analyzer.
+ */
+class ArmDecodedInstruction {
+public:
+    /** Maximal number of operands of a kept instruction. */
+    static const int MAX_OPERANDS = 4;
+
+private:
+    /**
+     * Operand of an instruction.
+     */
+    struct Operand {
+        int32_t value; ///< Immediate value or displacement.
+        uint16_t reg; ///< Register or base register.
+        uint8_t index; ///< Index register.
+        int8_t scale; ///< Scale of the index register.
+        uint8_t type; ///< Type of the operand.
+        uint8_t shiftType; ///< Type of the shift.
+        uint8_t shiftValue; ///< Shift amount or register.
+        bool subtracted; ///< Whether the operand is subtracted.
+    };
+
+    uint16_t id_; ///< Instruction id.
+    uint8_t cc_; ///< Condition code.
+    bool updateFlags_; ///< Whether the instruction updates flags.
+    bool writeback_; ///< Whether the instruction writes back.
+    uint8_t opCount_; ///< Number of operands.
+    Operand operands_[MAX_OPERANDS]; ///< Operands.
+
+public:
+    /**
+     * Constructs an invalid decoded instruction.
+     */
+    ArmDecodedInstruction(): id_(ARM_INS_INVALID), cc_(ARM_CC_INVALID), updateFlags_(false), writeback_(false), opCount_(0) {}
+
+    /**
+     * Constructor. If the instruction does not fit into this object,
+     * an invalid decoded instruction is constructed.
+     *
+     * \param instr Instruction decoded by Capstone with details turned on.
+     */
+    explicit ArmDecodedInstruction(const cs_insn &instr): ArmDecodedInstruction() {
+        static_assert(ARM_INS_ENDING <= UINT16_MAX, "Instruction ids must fit into 16 bits.");
+
+        const cs_arm &detail = instr.detail->arm;
+        if (detail.op_count > MAX_OPERANDS) {
+            return;
+        }
+
+        for (int i = 0; i < detail.op_count; ++i) {
+            const cs_arm_op &operand = detail.operands[i];
+            Operand &result = operands_[i];
+
+            result.value = 0;
+            result.reg = 0;
+            result.index = 0;
+            result.scale = 0;
+
+            switch (operand.type) {
+                case ARM_OP_REG: /* FALLTHROUGH */
+                case ARM_OP_SYSREG:
+                    if (operand.reg > UINT16_MAX) {
+                        return;
+                    }
+                    result.reg = static_cast<uint16_t>(operand.reg);
+                    break;
+                case ARM_OP_IMM: /* FALLTHROUGH */
+                case ARM_OP_CIMM: /* FALLTHROUGH */
+                case ARM_OP_PIMM:
+                    result.value = operand.imm;
+                    break;
+                case ARM_OP_MEM:
+                    if (operand.mem.base > UINT16_MAX || operand.mem.index > UINT8_MAX ||
+                        operand.mem.scale < INT8_MIN || operand.mem.scale > INT8_MAX) {
+                        return;
+                    }
+                    result.value = operand.mem.disp;
+                    result.reg = static_cast<uint16_t>(operand.mem.base);
+                    result.index = static_cast<uint8_t>(operand.mem.index);
+                    result.scale = static_cast<int8_t>(operand.mem.scale);
+                    break;
+                default:
+                    /* The analyzer does not look at the values of other operands. */
+                    break;
+            }
+
+            if (operand.shift.value > UINT8_MAX) {
+                return;
+            }
+            result.type = static_cast<uint8_t>(operand.type);
+            result.shiftType = static_cast<uint8_t>(operand.shift.type);
+            result.shiftValue = static_cast<uint8_t>(operand.shift.value);
+            result.subtracted = operand.subtracted;
+        }
+
+        cc_ = static_cast<uint8_t>(detail.cc);
+        updateFlags_ = detail.update_flags;
+        writeback_ = detail.writeback;
+        opCount_ = detail.op_count;
+        id_ = static_cast<uint16_t>(instr.id);
+    }
+
+    /**
+     * \return True if this object holds a decoded instruction.
+     */
+    bool isValid() const { return id_ != ARM_INS_INVALID; }
+
+    /**
+     * \return Instruction id.
+     */
+    unsigned int id() const { return id_; }
+
+    /**
+     * Fills the given details structure as Capstone would do.
+     * The fields not saved in this object are zeroed.
+     *
+     * \param[out] detail Details structure.
+     */
+    void restore(cs_arm &detail) const {
+        assert(isValid());
+
+        detail = cs_arm();
+        detail.cc = static_cast<arm_cc>(cc_);
+        detail.update_flags = updateFlags_;
+        detail.writeback = writeback_;
+        detail.op_count = opCount_;
+
+        for (int i = 0; i < opCount_; ++i) {
+            const Operand &operand = operands_[i];
+            cs_arm_op &result = detail.operands[i];
+
+            result.vector_index = -1;
+            result.type = static_cast<arm_op_type>(operand.type);
+
+            switch (result.type) {
+                case ARM_OP_REG: /* FALLTHROUGH */
+                case ARM_OP_SYSREG:
+                    result.reg = operand.reg;
+                    break;
+                case ARM_OP_IMM: /* FALLTHROUGH */
+                case ARM_OP_CIMM: /* FALLTHROUGH */
+                case ARM_OP_PIMM:
+                    result.imm = operand.value;
+                    break;
+                case ARM_OP_MEM:
+                    result.mem.base = operand.reg;
+                    result.mem.index = operand.index;
+                    result.mem.scale = operand.scale;
+                    result.mem.disp = operand.value;
+                    break;
+                default:
+                    break;
+            }
+
+            result.shift.type = static_cast<arm_shifter>(operand.shiftType);
+            result.shift.value = operand.shiftValue;
+            result.subtracted = operand.subtracted;
+        }
+    }
+};
+
+/**
+ * An instruction of ARM platform.
+ */
+class ArmInstruction: public core::arch::CapstoneInstruction<CS_ARCH_ARM, 4> {
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+    /** Decoded form of the instruction. */
+    ArmDecodedInstruction decoded_;
+#endif
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param[in] csMode Encoding mode of this instruction, as denoted in Capstone.
+     * \param[in] addr Instruction address in bytes.
+     * \param[in] size Instruction size in bytes.
+     * \param[in] bytes Valid pointer to the bytes of the instruction.
+     */
+    ArmInstruction(int csMode, ByteAddr addr, SmallByteSize size, const void *bytes):
+        core::arch::CapstoneInstruction<CS_ARCH_ARM, 4>(csMode, addr, size, bytes)
+    {}
+
+    /**
+     * Remembers the decoded form of the instruction, if this is
+     * enabled by NC_KEEP_DECODED_INSTRUCTIONS.
+     *
+     * \param[in] instr This instruction decoded by Capstone with details turned on.
+     */
+    void setDecoded(const cs_insn &instr) {
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+        decoded_ = ArmDecodedInstruction(instr);
+#else
+        NC_UNUSED(instr);
+#endif
+    }
+
+    /**
+     * \return Pointer to the decoded form of the instruction, if it was kept.
+     *         Can be nullptr.
+     */
+    const ArmDecodedInstruction *decoded() const {
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+        return decoded_.isValid() ? &decoded_ : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+};
 
 }}} // namespace nc::arch::arm
 
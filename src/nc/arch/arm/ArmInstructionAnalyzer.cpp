@@ -58,6 +58,8 @@ class ArmInstructionAnalyzerImpl {
     core::ir::Program *program_;
     const ArmInstruction *instruction_;
     core::arch::CapstoneInstructionPtr instr_;
+    cs_arm decodedDetail_;
+    unsigned int id_;
     const cs_arm *detail_;
 
 public:
@@ -72,9 +74,16 @@ public:
         program_ = program;
         instruction_ = instruction;
 
-        instr_ = disassemble(instruction);
-        assert(instr_ != nullptr);
-        detail_ = &instr_->detail->arm;
+        if (auto decoded = instruction->decoded()) {
+            decoded->restore(decodedDetail_);
+            id_ = decoded->id();
+            detail_ = &decodedDetail_;
+        } else {
+            instr_ = disassemble(instruction);
+            assert(instr_ != nullptr);
+            id_ = instr_->id;
+            detail_ = &instr_->detail->arm;
+        }
 
         auto instructionBasicBlock = program_->getBasicBlockForInstruction(instruction_);
 
@@ -170,7 +179,7 @@ private:
             pc ^= constant(instruction_->addr() + 2 * instruction_->size())
         ];
 
-        switch (instr_->id) {
+        switch (id_) {
         case ARM_INS_ADD: {
             _[operand(0) ^= operand(1) + operand(2)];
             if (!handleWriteToPC(bodyBasicBlock)) {
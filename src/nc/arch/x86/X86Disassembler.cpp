@@ -25,6 +25,7 @@
 #include "X86Disassembler.h"
 
 #include <nc/common/CheckedCast.h>
+#include <nc/common/make_unique.h>
 
 #include "X86Architecture.h"
 #include "X86Instruction.h"
@@ -38,7 +39,7 @@ X86Disassembler::X86Disassembler(const X86Architecture *architecture): core::arc
     ud_set_mode(&ud_obj_, architecture->bitness());
 }
 
-std::shared_ptr<core::arch::Instruction> X86Disassembler::disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) {
+std::unique_ptr<core::arch::Instruction> X86Disassembler::disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) {
     ud_set_pc(&ud_obj_, pc);
     ud_set_input_buffer(&ud_obj_, const_cast<uint8_t *>(static_cast<const uint8_t *>(buffer)), checked_cast<std::size_t>(size));
 
@@ -52,7 +53,9 @@ std::shared_ptr<core::arch::Instruction> X86Disassembler::disassembleSingleInstr
         return nullptr;
     }
 
-    return std::make_shared<X86Instruction>(ud_obj_.dis_mode, pc, instructionSize, buffer);
+    auto result = std::make_unique<X86Instruction>(ud_obj_.dis_mode, pc, instructionSize, buffer);
+    result->setDecoded(ud_obj_);
+    return result;
 }
 
 } // namespace x86
@@ -50,7 +50,7 @@ public:
     explicit
     X86Disassembler(const X86Architecture *architecture);
 
-    std::shared_ptr<core::arch::Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) override;
+    std::unique_ptr<core::arch::Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) override;
 };
 
 } // namespace x86
@@ -32,6 +32,52 @@ namespace nc {
 namespace arch {
 namespace x86 {
 
+X86DecodedInstruction::X86DecodedInstruction(const ud_t &ud):
+    mnemonic_(ud.mnemonic),
+    oprMode_(ud.opr_mode),
+    adrMode_(ud.adr_mode),
+    prefixes_((ud.pfx_rep ? REP : 0) | (ud.pfx_repe ? REPE : 0) | (ud.pfx_repne ? REPNE : 0))
+{
+    static_assert(sizeof(ud.operand) / sizeof(ud.operand[0]) == NOPERANDS, "Wrong number of operands.");
+    static_assert(sizeof(ud.operand[0].lval) == sizeof(lval_[0]), "Operand values must be of the same size.");
+    static_assert(UD_OP_CONST < 256, "Operand types and registers must fit into a byte.");
+
+    for (int i = 0; i < NOPERANDS; ++i) {
+        const ud_operand &operand = ud.operand[i];
+
+        memcpy(&lval_[i], &operand.lval, sizeof(lval_[i]));
+        type_[i] = static_cast<uint8_t>(operand.type);
+        size_[i] = operand.size;
+        base_[i] = static_cast<uint8_t>(operand.base);
+        index_[i] = static_cast<uint8_t>(operand.index);
+        offset_[i] = operand.offset;
+        scale_[i] = operand.scale;
+    }
+}
+
+void X86DecodedInstruction::restore(ud_t &ud, ByteAddr pc) const {
+    assert(isValid());
+
+    ud.mnemonic = mnemonic_;
+    for (int i = 0; i < NOPERANDS; ++i) {
+        ud_operand &operand = ud.operand[i];
+
+        memcpy(&operand.lval, &lval_[i], sizeof(lval_[i]));
+        operand.type = static_cast<ud_type>(type_[i]);
+        operand.size = size_[i];
+        operand.base = static_cast<ud_type>(base_[i]);
+        operand.index = static_cast<ud_type>(index_[i]);
+        operand.offset = offset_[i];
+        operand.scale = scale_[i];
+    }
+    ud.opr_mode = oprMode_;
+    ud.adr_mode = adrMode_;
+    ud.pfx_rep = prefixes_ & REP ? 0xF3 : 0;
+    ud.pfx_repe = prefixes_ & REPE ? 0xF3 : 0;
+    ud.pfx_repne = prefixes_ & REPNE ? 0xF2 : 0;
+    ud.pc = pc;
+}
+
 void X86Instruction::print(QTextStream &out) const {
     ud_t ud_obj;
 
@@ -30,13 +30,72 @@
 #include <cstring>
 
 #include <nc/common/CheckedCast.h>
+#include <nc/common/Unused.h>
 
 #include <nc/core/arch/Instruction.h>
 
+#include "udis86.h"
+
 namespace nc {
 namespace arch {
 namespace x86 {
 
+/**
+ * Decoded form of an x86 instruction: the part of udis86's decoder state
+ * that X86InstructionAnalyzer works with, packed into 48 bytes.
+ */
+class X86DecodedInstruction {
+    /** Number of operands of an instruction. */
+    static const int NOPERANDS = 3;
+
+    /** Flags of REP prefixes. */
+    enum {
+        REP   = 1 << 0, ///< REP prefix.
+        REPE  = 1 << 1, ///< REPE prefix.
+        REPNE = 1 << 2  ///< REPNE prefix.
+    };
+
+    uint64_t lval_[NOPERANDS]; ///< Values of the operands (ud_operand::lval).
+    uint8_t type_[NOPERANDS]; ///< Types of the operands.
+    uint8_t size_[NOPERANDS]; ///< Sizes of the operands.
+    uint8_t base_[NOPERANDS]; ///< Base registers of the operands.
+    uint8_t index_[NOPERANDS]; ///< Index registers of the operands.
+    uint8_t offset_[NOPERANDS]; ///< Sizes of the offsets of the operands.
+    uint8_t scale_[NOPERANDS]; ///< Scales of the operands.
+    ud_mnemonic_code mnemonic_; ///< Mnemonic.
+    uint8_t oprMode_; ///< Operand size mode.
+    uint8_t adrMode_; ///< Address size mode.
+    uint8_t prefixes_; ///< REP prefix flags.
+
+public:
+    /**
+     * Constructs an invalid decoded instruction.
+     */
+    X86DecodedInstruction(): mnemonic_(UD_Iinvalid) {}
+
+    /**
+     * Constructor.
+     *
+     * \param ud udis86's state after decoding an instruction.
+     */
+    explicit X86DecodedInstruction(const ud_t &ud);
+
+    /**
+     * \return True if this object holds a decoded instruction.
+     */
+    bool isValid() const { return mnemonic_ != UD_Iinvalid; }
+
+    /**
+     * Copies the decoded instruction into the udis86's state,
+     * as if udis86 has just decoded the instruction.
+     * Only the fields saved in this object are written.
+     *
+     * \param ud udis86's state.
+     * \param pc Address of the next instruction.
+     */
+    void restore(ud_t &ud, ByteAddr pc) const;
+};
+
 /**
  * An instruction of Intel x86 platform.
  */
@@ -52,6 +111,11 @@ private:
     /** Copy of architecture's bitness value. */
     uint8_t bitness_;
 
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+    /** Decoded form of the instruction. */
+    X86DecodedInstruction decoded_;
+#endif
+
 public:
     /**
      * Class constructor.
@@ -75,6 +139,32 @@ public:
      */
     const uint8_t *bytes() const { return &bytes_[0]; }
 
+    /**
+     * Remembers the decoded form of the instruction, if this is
+     * enabled by NC_KEEP_DECODED_INSTRUCTIONS.
+     *
+     * \param[in] ud udis86's state after decoding this instruction.
+     */
+    void setDecoded(const ud_t &ud) {
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+        decoded_ = X86DecodedInstruction(ud);
+#else
+        NC_UNUSED(ud);
+#endif
+    }
+
+    /**
+     * \return Pointer to the decoded form of the instruction, if it was kept.
+     *         Can be nullptr.
+     */
+    const X86DecodedInstruction *decoded() const {
+#ifdef NC_KEEP_DECODED_INSTRUCTIONS
+        return decoded_.isValid() ? &decoded_ : nullptr;
+#else
+        return nullptr;
+#endif
+    }
+
     virtual void print(QTextStream &out) const override;
 };
 
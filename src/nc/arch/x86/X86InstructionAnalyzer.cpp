@@ -111,9 +111,13 @@ public:
 
         currentInstruction_ = instr;
 
-        ud_set_pc(&ud_obj_, instr->addr());
-        ud_set_input_buffer(&ud_obj_, const_cast<uint8_t *>(instr->bytes()), checked_cast<std::size_t>(instr->size()));
-        ud_disassemble(&ud_obj_);
+        if (auto decoded = instr->decoded()) {
+            decoded->restore(ud_obj_, instr->endAddr());
+        } else {
+            ud_set_pc(&ud_obj_, instr->addr());
+            ud_set_input_buffer(&ud_obj_, const_cast<uint8_t *>(instr->bytes()), checked_cast<std::size_t>(instr->size()));
+            ud_disassemble(&ud_obj_);
+        }
 
         assert(ud_obj_.mnemonic != UD_Iinvalid);
 
@@ -0,0 +1,101 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cstddef>
+
+#include <QElapsedTimer>
+
+namespace nc {
+
+/**
+ * Limits on the work spent on analyzing a single function.
+ * A zero limit means no limit.
+ */
+class Budget {
+    /** Wall time limit, in milliseconds. */
+    qint64 timeLimit_;
+
+    /** Limit on the number of iterations of an analysis' fixpoint loop. */
+    std::size_t iterationLimit_;
+
+    /** Limit on the size of the function, in statements. */
+    std::size_t sizeLimit_;
+
+    /** Timer started when the analysis starts. */
+    QElapsedTimer timer_;
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param timeLimit      Wall time limit, in milliseconds.
+     * \param iterationLimit Limit on the number of iterations of an analysis' fixpoint loop.
+     * \param sizeLimit      Limit on the size of the function, in statements.
+     */
+    explicit Budget(qint64 timeLimit = 0, std::size_t iterationLimit = 0, std::size_t sizeLimit = 0):
+        timeLimit_(timeLimit), iterationLimit_(iterationLimit), sizeLimit_(sizeLimit)
+    {}
+
+    /**
+     * \return Wall time limit, in milliseconds.
+     */
+    qint64 timeLimit() const { return timeLimit_; }
+
+    /**
+     * \return Limit on the number of iterations of an analysis' fixpoint loop.
+     */
+    std::size_t iterationLimit() const { return iterationLimit_; }
+
+    /**
+     * \return Limit on the size of the function, in statements.
+     */
+    std::size_t sizeLimit() const { return sizeLimit_; }
+
+    /**
+     * \return True iff no limits are set.
+     */
+    bool isUnlimited() const { return timeLimit_ == 0 && iterationLimit_ == 0 && sizeLimit_ == 0; }
+
+    /**
+     * Starts counting the wall time.
+     */
+    void start() { timer_.start(); }
+
+    /**
+     * \return True iff the wall time limit is exceeded.
+     */
+    bool isTimeExceeded() const { return timeLimit_ > 0 && timer_.isValid() && timer_.hasExpired(timeLimit_); }
+
+    /**
+     * \param niterations Number of iterations done.
+     *
+     * \return True iff the given number of iterations exhausts the iteration limit.
+     */
+    bool isIterationLimitReached(std::size_t niterations) const {
+        return iterationLimit_ > 0 && niterations >= iterationLimit_;
+    }
+
+    /**
+     * \param size Size of the function, in statements.
+     *
+     * \return True iff the function is too big.
+     */
+    bool isSizeExceeded(std::size_t size) const { return sizeLimit_ > 0 && size > sizeLimit_; }
+
+    /**
+     * \param niterations Number of iterations done.
+     *
+     * \return True iff the time limit is exceeded or the iteration limit is reached.
+     */
+    bool isExhausted(std::size_t niterations) const {
+        return isTimeExceeded() || isIterationLimitReached(niterations);
+    }
+};
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -96,6 +96,33 @@ QString escapeCString(const QString &string) {
     return result;
 }
 
+QString escapeTsvString(const QString &string) {
+    QString result;
+    result.reserve(string.size());
+
+    foreach (QChar c, string) {
+        switch (c.toLatin1()) {
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            default:
+                result += c;
+                break;
+        }
+    }
+
+    return result;
+}
+
 } // namespace nc
 
 /* vim:set et sts=4 sw=4: */
@@ -35,6 +35,7 @@ namespace nc {
 
 QString escapeDotString(const QString &string);
 QString escapeCString(const QString &string);
+QString escapeTsvString(const QString &string);
 
 } // namespace nc
 
@@ -0,0 +1,76 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <boost/optional.hpp>
+
+#include <QString>
+#include <QtGlobal>
+
+#include "Types.h"
+
+namespace nc {
+
+/**
+ * Structured record about a completed piece of work, e.g. an analysis pass
+ * run on a function. Cheap to construct: no strings are formatted.
+ */
+class LogEvent {
+    /** Name of the pass. */
+    const char *pass_;
+
+    /** Address of the function the pass was run on, if any. */
+    boost::optional<ByteAddr> address_;
+
+    /** Time the pass took, in milliseconds. */
+    qint64 duration_;
+
+    /** Tag telling where the event comes from, e.g. the name of the input. Can be empty. */
+    QString tag_;
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param pass     Valid pointer to a string literal with the name of the pass.
+     * \param address  Address of the function the pass was run on, if any.
+     * \param duration Time the pass took, in milliseconds.
+     */
+    LogEvent(const char *pass, boost::optional<ByteAddr> address, qint64 duration):
+        pass_(pass), address_(address), duration_(duration)
+    {}
+
+    /**
+     * \return Valid pointer to the name of the pass.
+     */
+    const char *pass() const { return pass_; }
+
+    /**
+     * \return Address of the function the pass was run on, if any.
+     */
+    const boost::optional<ByteAddr> &address() const { return address_; }
+
+    /**
+     * \return Time the pass took, in milliseconds.
+     */
+    qint64 duration() const { return duration_; }
+
+    /**
+     * \return Tag telling where the event comes from. Can be empty.
+     */
+    const QString &tag() const { return tag_; }
+
+    /**
+     * Sets the tag telling where the event comes from.
+     *
+     * \param tag Tag.
+     */
+    void setTag(const QString &tag) { tag_ = tag; }
+};
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
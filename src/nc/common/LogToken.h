@@ -27,6 +27,7 @@
 
 #include <cassert>
 #include <memory>
+#include <utility>
 
 #include "Logger.h"
 
@@ -58,6 +59,13 @@ public:
         assert(logger_);
     }
 
+    /**
+     * \param level Log level.
+     *
+     * \return True iff messages of the given level will be logged.
+     */
+    bool isEnabled(LogLevel level) const { return logger_ && logger_->isEnabled(level); }
+
     /**
      * Logs a message with a given level.
      *
@@ -65,38 +73,72 @@ public:
      * \param[in] text  Text of the message.
      */
     void log(LogLevel level, const QString &text) const {
-        if (logger_) {
+        if (isEnabled(level)) {
             logger_->log(level, text);
         }
     }
 
+    /**
+     * Logs a message with a given level.
+     * The message is formatted only if it will be logged.
+     *
+     * \param[in] level  Log level of the message.
+     * \param[in] format Functor returning the text of the message.
+     */
+    template<class Format, class = decltype(std::declval<Format>()())>
+    void log(LogLevel level, Format &&format) const {
+        if (isEnabled(level)) {
+            logger_->log(level, format());
+        }
+    }
+
     /**
      * Logs a message with the debug level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a functor returning it.
      */
-    void debug(const QString &text) const { log(LogLevel::DEBUG, text); }
+    template<class Text>
+    void debug(Text &&text) const { log(LogLevel::DEBUG, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the info level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a functor returning it.
      */
-    void info(const QString &text) const { log(LogLevel::INFO, text); }
+    template<class Text>
+    void info(Text &&text) const { log(LogLevel::INFO, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the warning level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a functor returning it.
      */
-    void warning(const QString &text) const { log(LogLevel::WARNING, text); }
+    template<class Text>
+    void warning(Text &&text) const { log(LogLevel::WARNING, std::forward<Text>(text)); }
 
     /**
      * Logs a message with the error level.
      *
-     * \param[in] text Text of the message.
+     * \param[in] text Text of the message, or a functor returning it.
+     */
+    template<class Text>
+    void error(Text &&text) const { log(LogLevel::ERROR, std::forward<Text>(text)); }
+
+    /**
+     * \return True iff structured events will be logged.
+     */
+    bool acceptsEvents() const { return logger_ && logger_->acceptsEvents(); }
+
+    /**
+     * Logs a structured event.
+     *
+     * \param[in] event Event.
      */
-    void error(const QString &text) const { log(LogLevel::ERROR, text); }
+    void event(const LogEvent &event) const {
+        if (acceptsEvents()) {
+            logger_->logEvent(event);
+        }
+    }
 };
 
 } // namespace nc
@@ -28,6 +28,9 @@
 #include <QCoreApplication>
 #include <QString>
 
+#include "LogEvent.h"
+#include "Unused.h"
+
 #include "LogLevel.h"
 
 namespace nc {
@@ -93,11 +96,33 @@ public:
 
     /**
      * Logs a message with a given level.
+     * This method can be called from several threads concurrently.
      *
      * \param[in] level Log level of the message.
      * \param[in] text  Text of the message.
      */
     virtual void log(LogLevel level, const QString &text) = 0;
+
+    /**
+     * \param level Log level.
+     *
+     * \return True iff the logger wants messages of the given level.
+     *         Messages of other levels are not even formatted.
+     */
+    virtual bool isEnabled(LogLevel level) const { NC_UNUSED(level); return true; }
+
+    /**
+     * \return True iff the logger wants structured events.
+     */
+    virtual bool acceptsEvents() const { return false; }
+
+    /**
+     * Logs a structured event.
+     * This method can be called from several threads concurrently.
+     *
+     * \param[in] event Event.
+     */
+    virtual void logEvent(const LogEvent &event) { NC_UNUSED(event); }
 };
 
 } // namespace nc
@@ -0,0 +1,122 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+
+#ifdef NC_USE_THREADS
+#include <QRunnable>
+#include <QThreadPool>
+#endif
+
+#include "Unused.h"
+
+namespace nc {
+
+namespace {
+
+#ifdef NC_USE_THREADS
+
+/**
+ * State shared by all the workers of a single parallelFor() call.
+ */
+class ParallelForState {
+    std::size_t count_;
+    const std::function<void(std::size_t)> &function_;
+
+    /** Next index to be processed. */
+    std::atomic<std::size_t> nextIndex_;
+
+    /** Set when some call has thrown. */
+    std::atomic<bool> failed_;
+
+    std::mutex mutex_;
+    std::size_t exceptionIndex_;
+    std::exception_ptr exception_;
+
+public:
+    ParallelForState(std::size_t count, const std::function<void(std::size_t)> &function):
+        count_(count), function_(function), nextIndex_(0), failed_(false),
+        exceptionIndex_(std::numeric_limits<std::size_t>::max())
+    {}
+
+    /**
+     * Processes indices until there are no more of them, or until some call throws.
+     */
+    void work() {
+        while (!failed_) {
+            std::size_t index = nextIndex_++;
+            if (index >= count_) {
+                break;
+            }
+            try {
+                function_(index);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (index < exceptionIndex_) {
+                    exceptionIndex_ = index;
+                    exception_ = std::current_exception();
+                }
+                failed_ = true;
+            }
+        }
+    }
+
+    /**
+     * Rethrows the exception thrown by the call with the smallest index, if any.
+     */
+    void rethrow() {
+        if (exception_) {
+            std::rethrow_exception(exception_);
+        }
+    }
+};
+
+class ParallelForWorker: public QRunnable {
+    ParallelForState &state_;
+
+public:
+    ParallelForWorker(ParallelForState &state): state_(state) {}
+
+    void run() override { state_.work(); }
+};
+
+#endif /* NC_USE_THREADS */
+
+} // anonymous namespace
+
+void parallelFor(std::size_t count, int threadCount, const std::function<void(std::size_t)> &function) {
+#ifdef NC_USE_THREADS
+    if (threadCount > 1 && count > 1) {
+        ParallelForState state(count, function);
+
+        auto nworkers = static_cast<int>(std::min<std::size_t>(count, threadCount)) - 1;
+
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(nworkers);
+        for (int i = 0; i < nworkers; ++i) {
+            threadPool.start(new ParallelForWorker(state));
+        }
+
+        state.work();
+        threadPool.waitForDone();
+        state.rethrow();
+        return;
+    }
+#else
+    NC_UNUSED(threadCount);
+#endif
+
+    for (std::size_t index = 0; index < count; ++index) {
+        function(index);
+    }
+}
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -0,0 +1,31 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cstddef> /* For std::size_t. */
+#include <functional>
+
+namespace nc {
+
+/**
+ * Calls a function for every index in [0, count), possibly using several threads.
+ *
+ * When threads are disabled or threadCount is not greater than one, the function
+ * is called sequentially in the order of indices, in the calling thread.
+ *
+ * If some calls throw an exception, indices not yet started are skipped,
+ * and, after all running calls finish, the exception thrown by the call
+ * with the smallest index is rethrown in the calling thread.
+ *
+ * \param count       Number of indices.
+ * \param threadCount Maximal number of threads to use, including the calling one.
+ * \param function    Function to be called for every index.
+ */
+void parallelFor(std::size_t count, int threadCount, const std::function<void(std::size_t)> &function);
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -5,10 +5,29 @@
 
 #include <QObject>
 
+#include "Escaping.h"
+
 namespace nc {
 
 void StreamLogger::log(LogLevel level, const QString &text) {
-    stream_ << tr("[%1] %2").arg(level.getName()).arg(text) << '\n';
+    auto message = tr("[%1] %2").arg(level.getName()).arg(text);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_ << message << '\n';
+}
+
+void StreamLogger::logEvent(const LogEvent &event) {
+    /* Tab-separated, so that the events are easy to process by scripts. */
+    auto message = QString("[Event]\t%1\t%2\t%3")
+        .arg(QLatin1String(event.pass()))
+        .arg(event.address() ? QString::number(*event.address(), 16) : QString("-"))
+        .arg(event.duration());
+    if (!event.tag().isEmpty()) {
+        message += '\t' + escapeTsvString(event.tag());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stream_ << message << '\n';
 }
 
 } // namespace nc
@@ -5,6 +5,8 @@
 
 #include <nc/config.h>
 
+#include <mutex>
+
 #include <QCoreApplication>
 #include <QTextStream>
 
@@ -19,16 +21,29 @@ class StreamLogger: public nc::Logger {
     Q_DECLARE_TR_FUNCTIONS(StreamLogger)
 
     QTextStream &stream_;
+    LogLevel minLevel_;
+    bool printMessages_;
+    bool printEvents_;
+    std::mutex mutex_;
 
 public:
     /**
      * Constructor.
      *
      * \param stream Reference to the stream to print messages to.
+     * \param minLevel Minimal level of messages to print.
+     * \param printEvents Whether to print structured events.
+     * \param printMessages Whether to print messages at all.
      */
-    StreamLogger(QTextStream &stream): stream_(stream) {}
+    StreamLogger(QTextStream &stream, LogLevel minLevel = LogLevel::LOWEST, bool printEvents = false,
+                 bool printMessages = true):
+        stream_(stream), minLevel_(minLevel), printMessages_(printMessages), printEvents_(printEvents)
+    {}
 
     void log(LogLevel level, const QString &text) override;
+    bool isEnabled(LogLevel level) const override { return printMessages_ && level >= minLevel_; }
+    bool acceptsEvents() const override { return printEvents_; }
+    void logEvent(const LogEvent &event) override;
 };
 
 } // namespace nc
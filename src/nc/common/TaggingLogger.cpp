@@ -0,0 +1,20 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "TaggingLogger.h"
+
+namespace nc {
+
+void TaggingLogger::log(LogLevel level, const QString &text) {
+    logger_->log(level, tag_ + QLatin1String(": ") + text);
+}
+
+void TaggingLogger::logEvent(const LogEvent &event) {
+    LogEvent taggedEvent(event);
+    taggedEvent.setTag(tag_);
+    logger_->logEvent(taggedEvent);
+}
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -0,0 +1,48 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cassert>
+#include <memory>
+
+#include <QString>
+
+#include "Logger.h"
+
+namespace nc {
+
+/**
+ * Logger prefixing messages and tagging events with a given tag
+ * (e.g. the name of the input being decompiled) before passing them
+ * to another logger. Makes the output of concurrent decompilations
+ * sharing a logger attributable.
+ */
+class TaggingLogger: public Logger {
+    std::shared_ptr<Logger> logger_;
+    QString tag_;
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param logger Valid pointer to the logger to pass messages and events to.
+     * \param tag Tag.
+     */
+    TaggingLogger(std::shared_ptr<Logger> logger, const QString &tag):
+        logger_(std::move(logger)), tag_(tag)
+    {
+        assert(logger_);
+    }
+
+    void log(LogLevel level, const QString &text) override;
+    bool isEnabled(LogLevel level) const override { return logger_->isEnabled(level); }
+    bool acceptsEvents() const override { return logger_->acceptsEvents(); }
+    void logEvent(const LogEvent &event) override;
+};
+
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -36,6 +36,7 @@
 #include <nc/core/ir/calling/Signatures.h>
 #include <nc/core/ir/cflow/Graphs.h>
 #include <nc/core/ir/dflow/Dataflows.h>
+#include <nc/core/ir/dflow/UsesMap.h>
 #include <nc/core/ir/liveness/Livenesses.h>
 #include <nc/core/ir/types/Types.h>
 #include <nc/core/ir/vars/Variables.h>
@@ -46,7 +47,8 @@ namespace core {
 
 Context::Context():
     image_(std::make_shared<image::Image>()),
-    instructions_(std::make_shared<arch::Instructions>())
+    instructions_(std::make_shared<arch::Instructions>()),
+    threadCount_(1)
 {}
 
 Context::~Context() {}
@@ -72,18 +74,42 @@ void Context::setConventions(std::unique_ptr<ir::calling::Conventions> conventio
     conventions_ = std::move(conventions);
 }
 
+std::unique_ptr<ir::calling::Conventions> Context::takeConventions() {
+    return std::move(conventions_);
+}
+
 void Context::setHooks(std::unique_ptr<ir::calling::Hooks> hooks) {
     hooks_ = std::move(hooks);
 }
 
+std::unique_ptr<ir::calling::Hooks> Context::takeHooks() {
+    return std::move(hooks_);
+}
+
 void Context::setSignatures(std::unique_ptr<ir::calling::Signatures> signatures) {
     signatures_ = std::move(signatures);
 }
 
+std::unique_ptr<ir::calling::Signatures> Context::takeSignatures() {
+    return std::move(signatures_);
+}
+
 void Context::setDataflows(std::unique_ptr<ir::dflow::Dataflows> dataflows) {
     dataflows_ = std::move(dataflows);
 }
 
+std::unique_ptr<ir::dflow::Dataflows> Context::takeDataflows() {
+    return std::move(dataflows_);
+}
+
+void Context::setSpeculativeDataflows(std::unique_ptr<ir::dflow::Dataflows> dataflows) {
+    speculativeDataflows_ = std::move(dataflows);
+}
+
+void Context::setUses(std::unique_ptr<ir::dflow::UsesMap> uses) {
+    uses_ = std::move(uses);
+}
+
 void Context::setVariables(std::unique_ptr<ir::vars::Variables> variables) {
     variables_ = std::move(variables);
 }
@@ -92,10 +118,22 @@ void Context::setLivenesses(std::unique_ptr<ir::liveness::Livenesses> livenesses
     livenesses_ = std::move(livenesses);
 }
 
+std::unique_ptr<ir::liveness::Livenesses> Context::takeLivenesses() {
+    return std::move(livenesses_);
+}
+
+void Context::setSpeculativeLivenesses(std::unique_ptr<ir::liveness::Livenesses> livenesses) {
+    speculativeLivenesses_ = std::move(livenesses);
+}
+
 void Context::setGraphs(std::unique_ptr<ir::cflow::Graphs> graphs) {
     graphs_ = std::move(graphs);
 }
 
+std::unique_ptr<ir::cflow::Graphs> Context::takeGraphs() {
+    return std::move(graphs_);
+}
+
 void Context::setTypes(std::unique_ptr<ir::types::Types> types) {
     types_ = std::move(types);
 }
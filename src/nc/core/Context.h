@@ -29,6 +29,9 @@
 
 #include <QObject>
 
+#include <boost/unordered_set.hpp>
+
+#include <nc/common/Budget.h>
 #include <nc/common/CancellationToken.h>
 #include <nc/common/LogToken.h>
 
@@ -58,6 +61,7 @@ namespace ir {
     }
     namespace dflow {
         class Dataflows;
+        class UsesMap;
     }
     namespace types {
         class Types;
@@ -88,13 +92,19 @@ class Context: public QObject {
     std::unique_ptr<ir::calling::Hooks> hooks_; ///< Hooks manager.
     std::unique_ptr<ir::calling::Signatures> signatures_; ///< Signatures.
     std::unique_ptr<ir::dflow::Dataflows> dataflows_; ///< Dataflows.
+    std::unique_ptr<ir::dflow::Dataflows> speculativeDataflows_; ///< Dataflows computed before reconstructing signatures.
+    std::unique_ptr<ir::dflow::UsesMap> uses_; ///< Use information computed from dataflows_.
     std::unique_ptr<ir::vars::Variables> variables_; ///< Reconstructed variables.
     std::unique_ptr<ir::cflow::Graphs> graphs_; ///< Structured graphs.
     std::unique_ptr<ir::liveness::Livenesses> livenesses_; ///< Liveness information.
+    std::unique_ptr<ir::liveness::Livenesses> speculativeLivenesses_; ///< Liveness information computed before reconstructing signatures.
     std::unique_ptr<ir::types::Types> types_; ///< Information about types.
     std::unique_ptr<likec::Tree> tree_; ///< Abstract syntax tree of the LikeC program.
     LogToken logToken_; ///< Log token.
     CancellationToken cancellationToken_; ///< Cancellation token.
+    int threadCount_; ///< Maximal number of threads used for disassembling and analyzing functions.
+    Budget budget_; ///< Limits on the work spent on each function in each analysis.
+    boost::unordered_set<const ir::Function *> reusedFunctions_; ///< Functions whose analysis results are reused.
 
 public:
     /**
@@ -172,6 +182,13 @@ public:
      */
     const ir::calling::Conventions *conventions() const { return conventions_.get(); }
 
+    /**
+     * Transfers the ownership of the assigned calling conventions to the caller.
+     *
+     * \return Pointer to the assigned calling conventions. Can be nullptr.
+     */
+    std::unique_ptr<ir::calling::Conventions> takeConventions();
+
     /**
      * Sets the hooks manager.
      *
@@ -189,6 +206,13 @@ public:
      */
     const ir::calling::Hooks *hooks() const { return hooks_.get(); }
 
+    /**
+     * Transfers the ownership of the hooks manager to the caller.
+     *
+     * \return Pointer to the hooks manager. Can be nullptr.
+     */
+    std::unique_ptr<ir::calling::Hooks> takeHooks();
+
     /**
      * Sets the reconstructed signatures.
      *
@@ -206,6 +230,13 @@ public:
      */
     const ir::calling::Signatures *signatures() const { return signatures_.get(); }
 
+    /**
+     * Transfers the ownership of the signatures to the caller.
+     *
+     * \return Pointer to the signatures. Can be nullptr.
+     */
+    std::unique_ptr<ir::calling::Signatures> takeSignatures();
+
     /**
      * Sets the dataflow information for all functions.
      *
@@ -223,6 +254,38 @@ public:
      */
     const ir::dflow::Dataflows *dataflows() const { return dataflows_.get(); }
 
+    /**
+     * Transfers the ownership of the dataflow information to the caller.
+     *
+     * \return Pointer to the dataflow information. Can be nullptr.
+     */
+    std::unique_ptr<ir::dflow::Dataflows> takeDataflows();
+
+    /**
+     * Sets the dataflow information computed for all functions before reconstructing signatures.
+     * It is kept for incremental re-decompilation.
+     *
+     * \param[in] dataflows Pointer to the dataflow information. Can be nullptr.
+     */
+    void setSpeculativeDataflows(std::unique_ptr<ir::dflow::Dataflows> dataflows);
+
+    /**
+     * \return Pointer to the dataflow information computed before reconstructing signatures. Can be nullptr.
+     */
+    ir::dflow::Dataflows *speculativeDataflows() { return speculativeDataflows_.get(); }
+
+    /**
+     * Sets the use information for all functions. It must be computed from the current dataflows.
+     *
+     * \param[in] uses Pointer to the use information. Can be nullptr.
+     */
+    void setUses(std::unique_ptr<ir::dflow::UsesMap> uses);
+
+    /**
+     * \return Pointer to the use information for all functions not exceeding their budget. Can be nullptr.
+     */
+    const ir::dflow::UsesMap *uses() const { return uses_.get(); }
+
     /**
      * Sets the information about reconstructed variables.
      *
@@ -252,6 +315,13 @@ public:
      */
     const ir::cflow::Graphs *graphs() const { return graphs_.get(); }
 
+    /**
+     * Transfers the ownership of the structured graphs to the caller.
+     *
+     * \return Pointer to the structured graphs. Can be nullptr.
+     */
+    std::unique_ptr<ir::cflow::Graphs> takeGraphs();
+
     /**
      * Sets the liveness information for all functions.
      *
@@ -269,6 +339,26 @@ public:
      */
     const ir::liveness::Livenesses *livenesses() const { return livenesses_.get(); }
 
+    /**
+     * Transfers the ownership of the liveness information to the caller.
+     *
+     * \return Pointer to the liveness information. Can be nullptr.
+     */
+    std::unique_ptr<ir::liveness::Livenesses> takeLivenesses();
+
+    /**
+     * Sets the liveness information computed for all functions before reconstructing signatures.
+     * It is kept for incremental re-decompilation.
+     *
+     * \param[in] livenesses Pointer to the liveness information. Can be nullptr.
+     */
+    void setSpeculativeLivenesses(std::unique_ptr<ir::liveness::Livenesses> livenesses);
+
+    /**
+     * \return Pointer to the liveness information computed before reconstructing signatures. Can be nullptr.
+     */
+    ir::liveness::Livenesses *speculativeLivenesses() { return speculativeLivenesses_.get(); }
+
     /**
      * Sets the information about types.
      *
@@ -317,6 +407,43 @@ public:
      */
     const LogToken &logToken() const { return logToken_; }
 
+    /**
+     * Sets the maximal number of threads used for disassembling and analyzing functions concurrently.
+     *
+     * \param threadCount Number of threads. Values less than two mean sequential analysis.
+     */
+    void setThreadCount(int threadCount) { threadCount_ = threadCount; }
+
+    /**
+     * \return Maximal number of threads used for disassembling and analyzing functions concurrently.
+     */
+    int threadCount() const { return threadCount_; }
+
+    /**
+     * Sets the limits on the work spent on each function in each analysis.
+     * Functions exceeding them are analyzed in a cheaper way and marked as degraded.
+     *
+     * \param budget Budget.
+     */
+    void setBudget(const Budget &budget) { budget_ = budget; }
+
+    /**
+     * \return Limits on the work spent on each function in each analysis.
+     */
+    const Budget &budget() const { return budget_; }
+
+    /**
+     * \return Functions taken over from a previous decompilation,
+     *         whose analysis results are reused instead of being recomputed.
+     */
+    boost::unordered_set<const ir::Function *> &reusedFunctions() { return reusedFunctions_; }
+
+    /**
+     * \return Functions taken over from a previous decompilation,
+     *         whose analysis results are reused instead of being recomputed.
+     */
+    const boost::unordered_set<const ir::Function *> &reusedFunctions() const { return reusedFunctions_; }
+
     Q_SIGNALS:
 
     /**
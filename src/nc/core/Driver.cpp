@@ -3,8 +3,6 @@
 
 #include "Driver.h"
 
-#include <QFile>
-
 #include <nc/common/Foreach.h>
 #include <nc/common/Exception.h>
 
@@ -12,6 +10,7 @@
 #include <nc/core/arch/Disassembler.h>
 #include <nc/core/arch/Instructions.h>
 #include <nc/core/image/Image.h>
+#include <nc/core/image/MappedFile.h>
 #include <nc/core/image/Section.h>
 #include <nc/core/input/Parser.h>
 #include <nc/core/input/ParserRepository.h>
@@ -25,19 +24,21 @@ namespace nc {
 namespace core {
 
 void Driver::parse(Context &context, const QString &filename) {
-    QFile source(filename);
+    auto file = std::make_shared<image::MappedFile>(filename);
 
-    if (!source.open(QIODevice::ReadOnly)) {
+    if (!file->open()) {
         throw nc::Exception(tr("Could not open file \"%1\" for reading.").arg(filename));
     }
 
+    auto source = file->device();
+
     context.logToken().info(tr("Choosing a parser for %1...").arg(filename));
 
     const input::Parser *suitableParser = nullptr;
 
     foreach(const input::Parser *parser, input::ParserRepository::instance()->parsers()) {
         context.logToken().info(tr("Trying %1 parser...").arg(parser->name()));
-        if (parser->canParse(&source)) {
+        if (parser->canParse(source)) {
             suitableParser = parser;
             break;
         }
@@ -50,9 +51,19 @@ void Driver::parse(Context &context, const QString &filename) {
 
     context.logToken().info(tr("Parsing using %1 parser...").arg(suitableParser->name()));
 
-    suitableParser->parse(&source, context.image().get(), context.logToken());
+    /* Sections of the image will reference the mapped contents of the file. */
+    const image::MappedFile *mappedFile = nullptr;
+    if (file->isMapped()) {
+        context.image()->addMappedFile(file);
+        mappedFile = file.get();
+    }
+
+    suitableParser->parse(source, context.image().get(), context.logToken(), mappedFile);
 
     context.logToken().info(tr("Parsing completed."));
+
+    context.logToken().info(tr("Demangling symbol names..."));
+    context.image()->demangleSymbols(context.threadCount());
 }
 
 void Driver::disassemble(Context &context) {
@@ -79,16 +90,20 @@ void Driver::disassemble(Context &context, const image::ByteSource *source, Byte
     context.logToken().info(tr("Disassemble addresses from %2 to %3...").arg(begin, 0, 16).arg(end, 0, 16));
 
     try {
-        auto newInstructions = std::make_shared<arch::Instructions>(*context.instructions());
+        std::vector<std::unique_ptr<const arch::Instruction>> instructions;
 
         context.image()->platform().architecture()->createDisassembler()->disassemble(
             context.image().get(),
             source,
             begin,
             end,
-            [&](std::shared_ptr<arch::Instruction> instr){ newInstructions->add(std::move(instr)); },
+            [&](std::unique_ptr<arch::Instruction> instr){ instructions.push_back(std::move(instr)); },
+            context.threadCount(),
             context.cancellationToken());
 
+        auto newInstructions = std::make_shared<arch::Instructions>(*context.instructions());
+        newInstructions->add(std::move(instructions));
+
         context.setInstructions(newInstructions);
 
         context.logToken().info(tr("Disassembly completed."));
@@ -106,6 +121,16 @@ void Driver::decompile(Context &context) {
     }
 }
 
+void Driver::decompile(Context &context, Context &previous) {
+    try {
+        context.image()->platform().architecture()->masterAnalyzer()->decompile(context, previous);
+    } catch (const CancellationException &) {
+        context.image()->platform().architecture()->masterAnalyzer()->returnReusedResults(context, previous);
+        context.logToken().info(tr("Decompilation canceled."));
+        throw;
+    }
+}
+
 } // namespace core
 } // namespace nc
 
@@ -66,6 +66,17 @@ public:
      * \param context Context.
      */
     static void decompile(Context &context);
+
+    /**
+     * Performs decompilation reusing the analysis results of the functions
+     * that did not change since the previous decompilation.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation of the same image.
+     *                 It cannot be reused once more, but can still be displayed
+     *                 while the new context exists.
+     */
+    static void decompile(Context &context, Context &previous);
 };
 
 } // namespace core
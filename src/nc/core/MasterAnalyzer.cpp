@@ -24,7 +24,17 @@
 
 #include "MasterAnalyzer.h"
 
+#include <cstdint> /* For std::uintptr_t. */
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <QElapsedTimer>
+
 #include <nc/common/Foreach.h>
+#include <nc/common/ParallelFor.h>
+#include <nc/common/Range.h>
+#include <nc/common/Unused.h>
 #include <nc/common/make_unique.h>
 
 #include <nc/core/Context.h>
@@ -35,8 +45,13 @@
 #include <nc/core/ir/Function.h>
 #include <nc/core/ir/Functions.h>
 #include <nc/core/ir/FunctionsGenerator.h>
+#include <nc/core/ir/Jump.h>
 #include <nc/core/ir/Program.h>
+#include <nc/core/ir/Statements.h>
+#include <nc/core/ir/Terms.h>
+#include <nc/core/ir/calling/CallSignature.h>
 #include <nc/core/ir/calling/Conventions.h>
+#include <nc/core/ir/calling/FunctionSignature.h>
 #include <nc/core/ir/calling/Hooks.h>
 #include <nc/core/ir/calling/SignatureAnalyzer.h>
 #include <nc/core/ir/calling/Signatures.h>
@@ -47,6 +62,8 @@
 #include <nc/core/ir/cgen/NameGenerator.h>
 #include <nc/core/ir/dflow/Dataflows.h>
 #include <nc/core/ir/dflow/DataflowAnalyzer.h>
+#include <nc/core/ir/dflow/Uses.h>
+#include <nc/core/ir/dflow/UsesMap.h>
 #include <nc/core/ir/liveness/Livenesses.h>
 #include <nc/core/ir/liveness/LivenessAnalyzer.h>
 #include <nc/core/ir/types/TypeAnalyzer.h>
@@ -60,6 +77,280 @@
 namespace nc {
 namespace core {
 
+namespace {
+
+/**
+ * Runs a per-function analysis on all functions of the context, except
+ * the reused ones, using up to context.threadCount() threads. The results
+ * are put into the given mapping in the order of functions, so that it does
+ * not depend on scheduling.
+ *
+ * \param context Context.
+ * \param results Mapping from a function to the result of its analysis.
+ * \param analysis Function computing the result of analysis of a given function.
+ */
+template<class Results, class Analysis>
+void analyzeFunctions(Context &context, Results &results, Analysis analysis) {
+    std::vector<ir::Function *> functions;
+    foreach (auto function, context.functions()->list()) {
+        if (!nc::contains(context.reusedFunctions(), function)) {
+            functions.push_back(function);
+        }
+    }
+    if (functions.empty()) {
+        return;
+    }
+
+    std::vector<decltype(analysis(functions.front()))> functionResults(functions.size());
+
+    parallelFor(functions.size(), context.threadCount(), [&](std::size_t i) {
+        functionResults[i] = analysis(functions[i]);
+        context.cancellationToken().poll();
+    });
+
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        results.emplace(functions[i], std::move(functionResults[i]));
+    }
+}
+
+/**
+ * Moves the results computed for the reused functions of the context into a new mapping.
+ *
+ * \param context Context.
+ * \param results Pointer to the mapping from a function to its analysis result. Can be nullptr.
+ *
+ * \return Valid pointer to the mapping containing only the results for the reused functions.
+ */
+template<class Results>
+std::unique_ptr<Results> takeReusedResults(const Context &context, Results *results) {
+    auto reusedResults = std::make_unique<Results>();
+
+    if (results) {
+        foreach (auto &functionAndResult, *results) {
+            if (nc::contains(context.reusedFunctions(), functionAndResult.first)) {
+                reusedResults->emplace(functionAndResult.first, std::move(functionAndResult.second));
+            }
+        }
+    }
+
+    return reusedResults;
+}
+
+typedef std::vector<std::uintptr_t> Fingerprint;
+
+/**
+ * \param basicBlock Pointer to a basic block. Can be nullptr.
+ *
+ * \return Value identifying the basic block by its address.
+ */
+std::uintptr_t getBasicBlockId(const ir::BasicBlock *basicBlock) {
+    if (basicBlock && basicBlock->address()) {
+        return *basicBlock->address() + 1;
+    }
+    return 0;
+}
+
+void addJumpTarget(Fingerprint &fingerprint, const ir::JumpTarget &target) {
+    if (target.table()) {
+        foreach (const auto &entry, *target.table()) {
+            fingerprint.push_back(getBasicBlockId(entry.basicBlock()));
+        }
+    } else {
+        fingerprint.push_back(getBasicBlockId(target.basicBlock()));
+    }
+}
+
+/**
+ * Computes a value that is equal for two functions if they consist of the same
+ * instructions, split into basic blocks and connected in the same way.
+ * Instructions are compared by identity, as unchanged instructions are shared
+ * between the sets of instructions before and after an edit.
+ *
+ * \param function Valid pointer to a function.
+ *
+ * \return Fingerprint of the function.
+ */
+Fingerprint getFingerprint(const ir::Function *function) {
+    Fingerprint result;
+
+    foreach (auto basicBlock, function->basicBlocks()) {
+        result.push_back(getBasicBlockId(basicBlock));
+
+        const arch::Instruction *lastInstruction = nullptr;
+        foreach (auto statement, basicBlock->statements()) {
+            if (statement->instruction() && statement->instruction() != lastInstruction) {
+                lastInstruction = statement->instruction();
+                result.push_back(reinterpret_cast<std::uintptr_t>(lastInstruction));
+            }
+            if (auto jump = statement->asJump()) {
+                addJumpTarget(result, jump->thenTarget());
+                addJumpTarget(result, jump->elseTarget());
+            }
+        }
+
+        result.push_back(0);
+    }
+
+    return result;
+}
+
+/**
+ * \return True if the two terms have the same structure, false otherwise.
+ *         Only the kinds of terms used in signatures are compared.
+ */
+bool equal(const ir::Term *a, const ir::Term *b) {
+    if (a == b) {
+        return true;
+    }
+    if (!a || !b || a->kind() != b->kind() || a->size() != b->size()) {
+        return false;
+    }
+    switch (a->kind()) {
+        case ir::Term::INT_CONST:
+            return a->asConstant()->value().value() == b->asConstant()->value().value();
+        case ir::Term::MEMORY_LOCATION_ACCESS:
+            return a->asMemoryLocationAccess()->memoryLocation() == b->asMemoryLocationAccess()->memoryLocation();
+        case ir::Term::DEREFERENCE:
+            return a->asDereference()->domain() == b->asDereference()->domain() &&
+                   equal(a->asDereference()->address(), b->asDereference()->address());
+        case ir::Term::BINARY_OPERATOR:
+            return a->asBinaryOperator()->operatorKind() == b->asBinaryOperator()->operatorKind() &&
+                   equal(a->asBinaryOperator()->left(), b->asBinaryOperator()->left()) &&
+                   equal(a->asBinaryOperator()->right(), b->asBinaryOperator()->right());
+        default:
+            return false;
+    }
+}
+
+/**
+ * \return True if the two signatures have equal arguments and return values, false otherwise.
+ */
+template<class Signature>
+bool equal(const Signature &a, const Signature &b) {
+    if (a.arguments().size() != b.arguments().size()) {
+        return false;
+    }
+    for (std::size_t i = 0; i < a.arguments().size(); ++i) {
+        if (!equal(a.arguments()[i].get(), b.arguments()[i].get())) {
+            return false;
+        }
+    }
+    return equal(a.returnValue().get(), b.returnValue().get());
+}
+
+/**
+ * Replaces the signatures of the function and of the calls in it by the
+ * previous signature objects equal to them. Hooks are cached by signature
+ * objects, so this makes the hooks of the previous decompilation valid again.
+ *
+ * \param function Valid pointer to a function.
+ * \param signatures Reconstructed signatures.
+ * \param previousSignatures Signatures from the previous decompilation.
+ *
+ * \return True if all the signatures were replaced, false otherwise.
+ */
+bool reusePreviousSignatures(const ir::Function *function, ir::calling::Signatures &signatures,
+                             const ir::calling::Signatures &previousSignatures)
+{
+    auto signature = signatures.getSignature(function);
+    auto &previousSignature = previousSignatures.getSignature(function);
+
+    if (signature != previousSignature) {
+        if (!signature || !previousSignature || signature->variadic() != previousSignature->variadic() ||
+            !equal(*signature, *previousSignature)) {
+            return false;
+        }
+        if (function->entry() && function->entry()->address() &&
+            signatures.getSignature(*function->entry()->address()) == signature) {
+            signatures.setSignature(*function->entry()->address(), previousSignature);
+        }
+        signatures.setSignature(function, previousSignature);
+    }
+
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto call = statement->asCall()) {
+                auto &callSignature = signatures.getSignature(call);
+                auto &previousCallSignature = previousSignatures.getSignature(call);
+
+                if (callSignature != previousCallSignature) {
+                    if (!callSignature || !previousCallSignature || !equal(*callSignature, *previousCallSignature)) {
+                        return false;
+                    }
+                    signatures.setSignature(call, previousCallSignature);
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \param function Valid pointer to a function.
+ * \param dataflow Dataflow information computed for the function.
+ * \param hooks Hooks manager.
+ * \param previousConventions Calling conventions from the previous decompilation.
+ *
+ * \return True if the calling conventions and the sizes of stack arguments
+ *         of the function and of all the functions called from it did not change,
+ *         false otherwise.
+ */
+bool conventionsUnchanged(const ir::Function *function, const ir::dflow::Dataflow &dataflow,
+                          const ir::calling::Hooks &hooks, const ir::calling::Conventions &previousConventions)
+{
+    auto unchanged = [&](const ir::calling::CalleeId &calleeId) {
+        return hooks.getConvention(calleeId) == previousConventions.getConvention(calleeId) &&
+               hooks.conventions().getStackArgumentsSize(calleeId) == previousConventions.getStackArgumentsSize(calleeId);
+    };
+
+    if (!unchanged(ir::calling::getCalleeId(function))) {
+        return false;
+    }
+
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto call = statement->asCall()) {
+                if (!unchanged(ir::calling::getCalleeId(call, dataflow))) {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \param function Valid pointer to a function.
+ *
+ * \return Number of statements in the function.
+ */
+std::size_t getStatementCount(const ir::Function *function) {
+    std::size_t result = 0;
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            NC_UNUSED(statement);
+            ++result;
+        }
+    }
+    return result;
+}
+
+/**
+ * \param function Valid pointer to a function.
+ *
+ * \return Entry address of the function, if known.
+ */
+boost::optional<ByteAddr> getFunctionAddress(const ir::Function *function) {
+    if (auto entry = function->entry()) {
+        return entry->address();
+    }
+    return boost::none;
+}
+
+} // anonymous namespace
+
 MasterAnalyzer::~MasterAnalyzer() {}
 
 void MasterAnalyzer::createProgram(Context &context) const {
@@ -84,6 +375,76 @@ void MasterAnalyzer::createFunctions(Context &context) const {
     context.setFunctions(std::move(functions));
 }
 
+void MasterAnalyzer::reuseFunctions(Context &context, Context &previous) const {
+    if (!previous.tree() || !previous.speculativeDataflows() || !previous.speculativeLivenesses() ||
+        previous.image() != context.image())
+    {
+        return;
+    }
+
+    context.logToken().info(tr("Looking for functions that did not change."));
+
+    boost::unordered_map<Fingerprint, ir::Function *> fingerprint2function;
+    foreach (auto function, previous.functions()->list()) {
+        fingerprint2function.emplace(getFingerprint(function), function);
+    }
+
+    auto functions = std::make_unique<ir::Functions>();
+
+    while (!context.functions()->list().empty()) {
+        auto function = context.functions()->list().pop_front();
+
+        auto i = fingerprint2function.find(getFingerprint(function.get()));
+        if (i != fingerprint2function.end()) {
+            context.reusedFunctions().insert(i->second);
+            functions->addFunction(previous.functions()->list().erase(i->second));
+            fingerprint2function.erase(i);
+        } else {
+            functions->addFunction(std::move(function));
+        }
+    }
+
+    context.setFunctions(std::move(functions));
+
+    if (context.reusedFunctions().empty()) {
+        return;
+    }
+
+    context.logToken().info(tr("Reusing analysis results of %1 functions.").arg(context.reusedFunctions().size()));
+
+    context.setConventions(previous.takeConventions());
+    context.setSignatures(previous.takeSignatures());
+    context.setHooks(previous.takeHooks());
+
+    context.hooks()->setConventionDetector([this, &context](const ir::calling::CalleeId &calleeId) {
+        this->detectCallingConvention(context, calleeId);
+    });
+
+    /*
+     * Calling conventions and signatures are reconstructed from scratch,
+     * as in a decompilation without reuse. The hooks refer to these objects,
+     * so they are cleared instead of being replaced. The previous ones are
+     * kept in the previous context for checkConventions() and reuseResults().
+     */
+    previous.setConventions(std::make_unique<ir::calling::Conventions>(std::move(*context.conventions())));
+    *context.conventions() = ir::calling::Conventions();
+    previous.setSignatures(std::make_unique<ir::calling::Signatures>(std::move(*context.signatures())));
+    *context.signatures() = ir::calling::Signatures();
+
+    /* The hooks of the functions that are not reused are destroyed together with them. */
+    previous.setHooks(std::make_unique<ir::calling::Hooks>(*previous.conventions(), *previous.signatures()));
+    foreach (auto function, previous.functions()->list()) {
+        context.hooks()->transfer(function, *previous.hooks());
+    }
+
+    context.setDataflows(takeReusedResults(context, previous.speculativeDataflows()));
+    context.setLivenesses(takeReusedResults(context, previous.speculativeLivenesses()));
+
+    /* The functions are gone from the previous context, so it cannot be reused once more. */
+    previous.setSpeculativeDataflows(nullptr);
+    previous.setSpeculativeLivenesses(nullptr);
+}
+
 void MasterAnalyzer::createHooks(Context &context) const {
     context.logToken().info(tr("Creating hooks."));
 
@@ -106,38 +467,168 @@ void MasterAnalyzer::detectCallingConvention(Context &context, const ir::calling
     }
 }
 
+void MasterAnalyzer::checkConventions(Context &context, Context &previous) const {
+    if (context.reusedFunctions().empty()) {
+        return;
+    }
+
+    /*
+     * Call hooks depend on the callee's calling convention and on the size
+     * of its stack arguments, which can be taken from the callee's code.
+     * Functions calling a changed callee are analyzed anew.
+     */
+    auto &reusedFunctions = context.reusedFunctions();
+    for (auto i = reusedFunctions.begin(); i != reusedFunctions.end();) {
+        if (conventionsUnchanged(*i, *context.dataflows()->at(*i), *context.hooks(), *previous.conventions())) {
+            ++i;
+        } else {
+            i = reusedFunctions.erase(i);
+        }
+    }
+
+    context.logToken().info(tr("Reusing analysis results of %1 functions with unchanged calling conventions.")
+        .arg(reusedFunctions.size()));
+}
+
 void MasterAnalyzer::dataflowAnalysis(Context &context) const {
     context.logToken().info(tr("Dataflow analysis."));
 
-    context.setDataflows(std::make_unique<ir::dflow::Dataflows>());
+    context.setDataflows(takeReusedResults(context, context.dataflows()));
 
     foreach (auto function, context.functions()->list()) {
-        dataflowAnalysis(context, function);
-        context.cancellationToken().poll();
+        if (nc::contains(context.reusedFunctions(), function)) {
+            context.hooks()->restore(function, context.dataflows()->at(function).get());
+        }
     }
+
+    analyzeFunctions(context, *context.dataflows(), [&](ir::Function *function) {
+        return dataflowAnalysis(context, function);
+    });
 }
 
-void MasterAnalyzer::dataflowAnalysis(Context &context, ir::Function *function) const {
-    context.logToken().info(tr("Dataflow analysis of %1.").arg(getFunctionName(context, function)));
+std::unique_ptr<ir::dflow::Dataflow> MasterAnalyzer::dataflowAnalysis(Context &context, ir::Function *function) const {
+    context.logToken().info([&]{ return tr("Dataflow analysis of %1.").arg(getFunctionName(context, function)); });
+
+    QElapsedTimer timer;
+    timer.start();
+
+    auto budget = context.budget();
+    if (!function->isDegraded() && budget.isSizeExceeded(getStatementCount(function))) {
+        markDegraded(context, function, "dataflow");
+    }
+    if (function->isDegraded()) {
+        /* Cheap fallback: widen the values changing after the first execution of a basic block. */
+        budget = Budget(budget.timeLimit(), 1);
+    }
+    budget.start();
 
     std::unique_ptr<ir::dflow::Dataflow> dataflow(new ir::dflow::Dataflow());
 
     context.hooks()->instrument(function, dataflow.get());
 
-    ir::dflow::DataflowAnalyzer(*dataflow, context.image()->platform().architecture(), context.cancellationToken(),
-                                context.logToken()).analyze(ir::CFG(function->basicBlocks()));
+    ir::dflow::DataflowAnalyzer analyzer(*dataflow, context.image()->platform().architecture(),
+                                         context.cancellationToken(), context.logToken());
+    if (!budget.isUnlimited()) {
+        analyzer.setBudget(&budget);
+    }
+    analyzer.analyze(ir::CFG(function->basicBlocks()));
+
+    if (analyzer.budgetExceeded() && !function->isDegraded()) {
+        markDegraded(context, function, "dataflow");
+    }
+
+    context.logToken().event(LogEvent("dataflow", getFunctionAddress(function), timer.elapsed()));
+
+    return dataflow;
+}
+
+void MasterAnalyzer::computeUses(Context &context) const {
+    context.logToken().info(tr("Computing uses."));
+
+    std::vector<std::pair<const ir::Function *, const ir::dflow::Dataflow *>> functions;
+    foreach (const auto &functionAndDataflow, *context.dataflows()) {
+        /* Uses of functions exceeding their budget are only needed for generating code, which computes them itself. */
+        if (functionAndDataflow.first->isDegraded()) {
+            continue;
+        }
+        functions.push_back(std::make_pair(functionAndDataflow.first, functionAndDataflow.second.get()));
+    }
+
+    std::vector<std::unique_ptr<const ir::dflow::Uses>> functionUses(functions.size());
 
-    context.dataflows()->emplace(function, std::move(dataflow));
+    parallelFor(functions.size(), context.threadCount(), [&](std::size_t i) {
+        functionUses[i] = std::make_unique<ir::dflow::Uses>(*functions[i].second);
+        context.cancellationToken().poll();
+    });
+
+    auto uses = std::make_unique<ir::dflow::UsesMap>();
+    for (std::size_t i = 0; i < functions.size(); ++i) {
+        uses->emplace(functions[i].first, std::move(functionUses[i]));
+    }
+
+    context.setUses(std::move(uses));
 }
 
 void MasterAnalyzer::reconstructSignatures(Context &context) const {
     context.logToken().info(tr("Reconstructing function signatures."));
 
-    ir::calling::SignatureAnalyzer(*context.signatures(), *context.dataflows(), *context.hooks(),
+    ir::calling::SignatureAnalyzer(*context.signatures(), *context.dataflows(), *context.uses(), *context.hooks(),
         *context.livenesses(), context.cancellationToken(), context.logToken())
         .analyze();
 }
 
+void MasterAnalyzer::reuseResults(Context &context, Context &previous) const {
+    context.setSpeculativeDataflows(context.takeDataflows());
+    context.setUses(nullptr);
+    context.setSpeculativeLivenesses(context.takeLivenesses());
+
+    if (context.reusedFunctions().empty()) {
+        return;
+    }
+
+    /* Functions whose own or call signatures have changed are analyzed anew. */
+    auto &reusedFunctions = context.reusedFunctions();
+    for (auto i = reusedFunctions.begin(); i != reusedFunctions.end();) {
+        if (reusePreviousSignatures(*i, *context.signatures(), *previous.signatures())) {
+            ++i;
+        } else {
+            i = reusedFunctions.erase(i);
+        }
+    }
+
+    context.logToken().info(tr("Reusing final analysis results of %1 functions.").arg(reusedFunctions.size()));
+
+    context.setDataflows(takeReusedResults(context, previous.dataflows()));
+    context.setLivenesses(takeReusedResults(context, previous.livenesses()));
+    context.setGraphs(takeReusedResults(context, previous.graphs()));
+}
+
+void MasterAnalyzer::returnReusedResults(Context &context, Context &previous) const {
+    if (!context.dataflows() || !previous.dataflows()) {
+        return;
+    }
+
+    foreach (auto &functionAndDataflow, *previous.dataflows()) {
+        if (!functionAndDataflow.second) {
+            auto i = context.dataflows()->find(functionAndDataflow.first);
+            if (i != context.dataflows()->end()) {
+                functionAndDataflow.second = std::move(i->second);
+            }
+        }
+    }
+}
+
+void MasterAnalyzer::releaseStaleHooks(Context &context, Context &previous) const {
+    /* Only hooks taken over from the previous decompilation can be stale. */
+    if (!previous.hooks()) {
+        return;
+    }
+
+    foreach (auto function, context.functions()->list()) {
+        context.hooks()->transferStale(function, *previous.hooks());
+    }
+}
+
 void MasterAnalyzer::reconstructVariables(Context &context) const {
     context.logToken().info(tr("Reconstructing variables."));
 
@@ -152,15 +643,18 @@ void MasterAnalyzer::reconstructVariables(Context &context) const {
 void MasterAnalyzer::livenessAnalysis(Context &context) const {
     context.logToken().info(tr("Liveness analysis."));
 
-    context.setLivenesses(std::make_unique<ir::liveness::Livenesses>());
+    context.setLivenesses(takeReusedResults(context, context.livenesses()));
 
-    foreach (const ir::Function *function, context.functions()->list()) {
-        livenessAnalysis(context, function);
-    }
+    analyzeFunctions(context, *context.livenesses(), [&](const ir::Function *function) {
+        return livenessAnalysis(context, function);
+    });
 }
 
-void MasterAnalyzer::livenessAnalysis(Context &context, const ir::Function *function) const {
-    context.logToken().info(tr("Liveness analysis of %1.").arg(getFunctionName(context, function)));
+std::unique_ptr<ir::liveness::Liveness> MasterAnalyzer::livenessAnalysis(Context &context, const ir::Function *function) const {
+    context.logToken().info([&]{ return tr("Liveness analysis of %1.").arg(getFunctionName(context, function)); });
+
+    QElapsedTimer timer;
+    timer.start();
 
     std::unique_ptr<ir::liveness::Liveness> liveness(new ir::liveness::Liveness());
 
@@ -170,7 +664,9 @@ void MasterAnalyzer::livenessAnalysis(Context &context, const ir::Function *func
         context.signatures(), context.logToken())
     .analyze();
 
-    context.livenesses()->emplace(function, std::move(liveness));
+    context.logToken().event(LogEvent("liveness", getFunctionAddress(function), timer.elapsed()));
+
+    return liveness;
 }
 
 void MasterAnalyzer::reconstructTypes(Context &context) const {
@@ -190,23 +686,49 @@ void MasterAnalyzer::reconstructTypes(Context &context) const {
 void MasterAnalyzer::structuralAnalysis(Context &context) const {
     context.logToken().info(tr("Structural analysis."));
 
-    context.setGraphs(std::make_unique<ir::cflow::Graphs>());
+    context.setGraphs(takeReusedResults(context, context.graphs()));
 
-    foreach (auto function, context.functions()->list()) {
-        structuralAnalysis(context, function);
-        context.cancellationToken().poll();
-    }
+    analyzeFunctions(context, *context.graphs(), [&](ir::Function *function) {
+        return structuralAnalysis(context, function);
+    });
 }
 
-void MasterAnalyzer::structuralAnalysis(Context &context, const ir::Function *function) const {
-    context.logToken().info(tr("Structural analysis of %1.").arg(getFunctionName(context, function)));
+std::unique_ptr<ir::cflow::Graph> MasterAnalyzer::structuralAnalysis(Context &context, ir::Function *function) const {
+    context.logToken().info([&]{ return tr("Structural analysis of %1.").arg(getFunctionName(context, function)); });
+
+    QElapsedTimer timer;
+    timer.start();
 
     std::unique_ptr<ir::cflow::Graph> graph(new ir::cflow::Graph());
 
     ir::cflow::GraphBuilder()(*graph, function);
-    ir::cflow::StructureAnalyzer(*graph, *context.dataflows()->at(function)).analyze();
 
-    context.graphs()->emplace(function, std::move(graph));
+    ir::cflow::StructureAnalyzer analyzer(*graph, *context.dataflows()->at(function));
+
+    /* Control flow of functions exceeding their budget is left unstructured. */
+    if (!function->isDegraded()) {
+        auto budget = context.budget();
+        budget.start();
+
+        if (!budget.isUnlimited()) {
+            analyzer.setBudget(&budget);
+        }
+        analyzer.analyze();
+
+        if (analyzer.budgetExceeded()) {
+            markDegraded(context, function, "structural");
+        }
+    }
+
+    auto elapsed = timer.elapsed();
+
+    context.logToken().debug([&]{
+        return tr("Structural analysis of %1 took %2 ms: %3 depth-first searches, %4 reductions.")
+            .arg(getFunctionName(context, function)).arg(elapsed).arg(analyzer.ndfs()).arg(analyzer.nreductions());
+    });
+    context.logToken().event(LogEvent("structural", getFunctionAddress(function), elapsed));
+
+    return graph;
 }
 
 void MasterAnalyzer::generateTree(Context &context) const {
@@ -215,7 +737,7 @@ void MasterAnalyzer::generateTree(Context &context) const {
     auto tree = std::make_unique<nc::core::likec::Tree>();
 
     ir::cgen::CodeGenerator(*tree, *context.image(), *context.functions(), *context.hooks(),
-        *context.signatures(), *context.dataflows(), *context.variables(), *context.graphs(),
+        *context.signatures(), *context.dataflows(), *context.uses(), *context.variables(), *context.graphs(),
         *context.livenesses(), *context.types(), context.cancellationToken())
         .makeCompilationUnit();
 
@@ -240,15 +762,86 @@ void MasterAnalyzer::decompile(Context &context) const {
     dataflowAnalysis(context);
     context.cancellationToken().poll();
 
+    computeUses(context);
+    context.cancellationToken().poll();
+
+    livenessAnalysis(context);
+    context.cancellationToken().poll();
+
+    reconstructSignatures(context);
+    context.cancellationToken().poll();
+
+    dataflowAnalysis(context);
+    context.cancellationToken().poll();
+
+    computeUses(context);
+    context.cancellationToken().poll();
+
+    reconstructVariables(context);
+    context.cancellationToken().poll();
+
+    structuralAnalysis(context);
+    context.cancellationToken().poll();
+
+    livenessAnalysis(context);
+    context.cancellationToken().poll();
+
+    reconstructTypes(context);
+    context.cancellationToken().poll();
+
+    generateTree(context);
+    context.cancellationToken().poll();
+
+    context.logToken().info(tr("Decompilation completed."));
+}
+
+void MasterAnalyzer::decompile(Context &context, Context &previous) const {
+    context.logToken().info(tr("Decompiling incrementally."));
+
+    createProgram(context);
+    context.cancellationToken().poll();
+
+    createFunctions(context);
+    context.cancellationToken().poll();
+
+    reuseFunctions(context, previous);
+    context.cancellationToken().poll();
+
+    if (!context.hooks()) {
+        createHooks(context);
+        context.cancellationToken().poll();
+    }
+
+    detectCallingConventions(context);
+    context.cancellationToken().poll();
+
+    checkConventions(context, previous);
+    context.cancellationToken().poll();
+
+    dataflowAnalysis(context);
+    context.cancellationToken().poll();
+
+    computeUses(context);
+    context.cancellationToken().poll();
+
     livenessAnalysis(context);
     context.cancellationToken().poll();
 
     reconstructSignatures(context);
     context.cancellationToken().poll();
 
+    reuseResults(context, previous);
+    context.cancellationToken().poll();
+
     dataflowAnalysis(context);
     context.cancellationToken().poll();
 
+    releaseStaleHooks(context, previous);
+    context.cancellationToken().poll();
+
+    computeUses(context);
+    context.cancellationToken().poll();
+
     reconstructVariables(context);
     context.cancellationToken().poll();
 
@@ -267,6 +860,15 @@ void MasterAnalyzer::decompile(Context &context) const {
     context.logToken().info(tr("Decompilation completed."));
 }
 
+void MasterAnalyzer::markDegraded(Context &context, ir::Function *function, const char *pass) const {
+    function->setDegraded();
+
+    context.logToken().warning([&]{
+        return tr("%1 exceeds its budget in %2 analysis and will be decompiled only partially.")
+            .arg(getFunctionName(context, function)).arg(QLatin1String(pass));
+    });
+}
+
 QString MasterAnalyzer::getFunctionName(Context &context, const ir::Function *function) const {
     return ir::cgen::NameGenerator(*context.image()).getFunctionName(function).name();
 }
@@ -25,6 +25,8 @@
 
 #include <nc/config.h>
 
+#include <memory> /* For std::unique_ptr. */
+
 #include <QCoreApplication> /* For Q_DECLARE_TR_FUNCTIONS. */
 
 namespace nc {
@@ -36,6 +38,15 @@ namespace ir {
     namespace calling {
         class CalleeId;
     }
+    namespace cflow {
+        class Graph;
+    }
+    namespace dflow {
+        class Dataflow;
+    }
+    namespace liveness {
+        class Liveness;
+    }
 }
 
 class Context;
@@ -50,6 +61,10 @@ class Context;
  * Methods of this class can be executed concurrently.
  * (Though, only on different context currently.)
  * Therefore, they all are const.
+ *
+ * Methods analyzing a single function can be called concurrently
+ * for different functions of the same context. Such methods must not
+ * modify the context: they return their results instead.
  */
 class MasterAnalyzer {
     Q_DECLARE_TR_FUNCTIONS(MasterAnalyzer)
@@ -74,6 +89,21 @@ public:
      */
     virtual void createFunctions(Context &context) const;
 
+    /**
+     * Replaces the functions of the context that did not change since
+     * the previous decompilation by their counterparts from the previous
+     * context, and takes over the hooks, calling conventions, and the results
+     * of dataflow and liveness analyses computed for them before reconstructing
+     * signatures. The reused functions are put into context.reusedFunctions().
+     * The hooks of the other previous functions are moved back to the previous context.
+     * Functions are considered unchanged if they consist of the same
+     * instructions connected in the same way.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation of the same image.
+     */
+    virtual void reuseFunctions(Context &context, Context &previous) const;
+
     /**
      * Creates the hooks manager.
      *
@@ -91,8 +121,19 @@ public:
      */
     virtual void detectCallingConvention(Context &context, const ir::calling::CalleeId &calleeId) const;
 
+    /**
+     * Removes from context.reusedFunctions() the functions whose own calling
+     * convention, or the calling convention or the size of stack arguments
+     * of a function called from them, has changed since the previous decompilation.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation, passed earlier to reuseFunctions().
+     */
+    virtual void checkConventions(Context &context, Context &previous) const;
+
     /**
      * Performs dataflow analysis of all functions.
+     * Functions are analyzed using up to context.threadCount() threads.
      *
      * \param context Context.
      */
@@ -103,8 +144,19 @@ public:
      *
      * \param context Context.
      * \param function Valid pointer to the function.
+     *
+     * \return Valid pointer to the dataflow information for the function.
+     */
+    virtual std::unique_ptr<ir::dflow::Dataflow> dataflowAnalysis(Context &context, ir::Function *function) const;
+
+    /**
+     * Computes use information from the dataflows of all functions
+     * not exceeding their budget.
+     * Functions are processed using up to context.threadCount() threads.
+     *
+     * \param context Context.
      */
-    virtual void dataflowAnalysis(Context &context, ir::Function *function) const;
+    virtual void computeUses(Context &context) const;
 
     /**
      * Reconstructs signatures of functions.
@@ -113,6 +165,37 @@ public:
      */
     virtual void reconstructSignatures(Context &context) const;
 
+    /**
+     * Keeps the results of dataflow and liveness analyses computed before
+     * reconstructing signatures for the next incremental decompilation.
+     * Removes from context.reusedFunctions() the functions whose own or call
+     * signatures have changed, and takes over the final results of dataflow,
+     * liveness, and structural analyses for the rest of the reused functions.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation, passed earlier to reuseFunctions().
+     */
+    virtual void reuseResults(Context &context, Context &previous) const;
+
+    /**
+     * Moves the final dataflow information taken over by reuseResults() back
+     * to the previous context, so that the previous decompilation results
+     * stay complete when the incremental decompilation is canceled.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation, passed earlier to reuseFunctions().
+     */
+    virtual void returnReusedResults(Context &context, Context &previous) const;
+
+    /**
+     * Moves the hooks that are no longer used after the final dataflow analysis
+     * to the previous context, so that they are destroyed together with it.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation, passed earlier to reuseFunctions().
+     */
+    virtual void releaseStaleHooks(Context &context, Context &previous) const;
+
     /**
      * Reconstructs local and global variables.
      *
@@ -122,6 +205,7 @@ public:
 
     /**
      * Performs liveness analysis on all functions.
+     * Functions are analyzed using up to context.threadCount() threads.
      *
      * \param context Context.
      */
@@ -132,11 +216,14 @@ public:
      *
      * \param context Context.
      * \param function Valid pointer to the function.
+     *
+     * \return Valid pointer to the liveness information for the function.
      */
-    virtual void livenessAnalysis(Context &context, const ir::Function *function) const;
+    virtual std::unique_ptr<ir::liveness::Liveness> livenessAnalysis(Context &context, const ir::Function *function) const;
 
     /**
      * Performs structural analysis of all functions.
+     * Functions are analyzed using up to context.threadCount() threads.
      *
      * \param context Context.
      */
@@ -147,8 +234,10 @@ public:
      *
      * \param context Context.
      * \param function Valid pointer to the function.
+     *
+     * \return Valid pointer to the structured graph of the function.
      */
-    virtual void structuralAnalysis(Context &context, const ir::Function *function) const;
+    virtual std::unique_ptr<ir::cflow::Graph> structuralAnalysis(Context &context, ir::Function *function) const;
 
     /**
      * Computes information about types.
@@ -171,7 +260,30 @@ public:
      */
     virtual void decompile(Context &context) const;
 
+    /**
+     * Decompiles the assembler program, reusing the analysis results of the functions
+     * that did not change since the previous decompilation. Variables, types,
+     * and the LikeC tree are always reconstructed for the whole program.
+     *
+     * \param context Context.
+     * \param previous Context of the previous decompilation of the same image.
+     *                 Its functions and analysis results are moved to the new
+     *                 context, therefore it cannot be reused once more. Its tree
+     *                 refers to the moved functions and stays valid as long as
+     *                 the new context exists.
+     */
+    virtual void decompile(Context &context, Context &previous) const;
+
 protected:
+    /**
+     * Marks the function as exceeding its analysis budget and logs a warning about it.
+     *
+     * \param context Context.
+     * \param function Valid pointer to a function.
+     * \param pass Valid pointer to the name of the analysis where the budget was exceeded.
+     */
+    void markDegraded(Context &context, ir::Function *function, const char *pass) const;
+
     /**
      * \param context Context.
      * \param function Valid pointer to a function.
@@ -4,12 +4,16 @@
 #include "Disassembler.h"
 
 #include <algorithm> /* std::max() */
+#include <vector>
 
 #include <nc/core/image/ByteSource.h>
 #include <nc/core/image/Image.h>
 #include <nc/core/image/Relocation.h>
+#include <nc/core/image/RelocationCursor.h>
 
 #include <nc/common/CancellationToken.h>
+#include <nc/common/Foreach.h>
+#include <nc/common/ParallelFor.h>
 
 #include "Architecture.h"
 #include "Instruction.h"
@@ -19,8 +23,14 @@ namespace core {
 namespace arch {
 
 void Disassembler::disassemble(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, const InstructionCallback &callback, const CancellationToken &canceled) {
+    sweep(image, source, begin, end, end, callback, nullptr, canceled);
+}
+
+ByteAddr Disassembler::sweep(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr limit, ByteAddr end,
+    const InstructionCallback &callback, const std::function<bool(ByteAddr)> &visit, const CancellationToken &canceled)
+{
     assert(source != nullptr);
-    assert(begin <= end);
+    assert(begin <= limit && limit <= end);
 
     const SmallByteSize maxInstructionSize = architecture_->maxInstructionSize();
     const ByteSize bufferSize = std::min(ByteSize(std::max(65536, maxInstructionSize)), end - begin);
@@ -29,13 +39,20 @@ void Disassembler::disassemble(const image::Image *image, const image::ByteSourc
     auto bufferBegin = begin;
     auto bufferEnd = begin;
 
-    for (ByteAddr pc = begin; pc < end; canceled.poll()) {
+    image::RelocationCursor relocations(image);
+
+    ByteAddr pc = begin;
+    for (; pc < limit; canceled.poll()) {
+        if (visit && !visit(pc)) {
+            break;
+        }
+
         if (pc + maxInstructionSize > bufferEnd && bufferEnd < end) {
             bufferBegin = pc;
             bufferEnd = bufferBegin + source->readBytes(pc, buffer.get(), std::min(bufferSize, end - pc));
         }
 
-        const image::Relocation* reloc = image->getRelocation(pc);
+        const image::Relocation *reloc = relocations.getRelocation(pc);
         // If a relocation starts at a particular address it does make sense for there to be an instruction
         // there as well so skip over it
         if (reloc) {
@@ -53,9 +70,100 @@ void Disassembler::disassemble(const image::Image *image, const image::ByteSourc
             ++pc;
         }
     }
+    return pc;
+}
+
+namespace {
+
+/**
+ * A part of the address range disassembled independently of the others.
+ */
+struct Shard {
+    ByteAddr begin; ///< First address of the shard.
+    ByteAddr limit; ///< First address past the shard.
+    ByteAddr stop; ///< Address at which disassembly of the shard stopped.
+    std::vector<bool> visited; ///< Whether disassembly of the shard passed through a given address.
+    std::vector<std::unique_ptr<Instruction>> instructions; ///< Instructions in the order of addresses.
+};
+
+} // anonymous namespace
+
+void Disassembler::disassemble(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end,
+    const InstructionCallback &callback, int threadCount, const CancellationToken &canceled)
+{
+    assert(source != nullptr);
+    assert(begin <= end);
+
+    /* Shards must be large enough to make resynchronization costs negligible. */
+    const ByteSize minShardSize = 1 << 20;
+
+    std::size_t shardCount = 1;
+    if (threadCount > 1) {
+        shardCount = static_cast<std::size_t>(std::min<ByteSize>((end - begin) / minShardSize, 4 * threadCount));
+    }
+    if (shardCount <= 1) {
+        disassemble(image, source, begin, end, callback, canceled);
+        return;
+    }
+
+    /*
+     * Disassemble the shards independently, remembering all the addresses
+     * through which the linear sweep of each shard went. The instructions
+     * crossing the end of a shard are decoded using the bytes after it.
+     */
+    std::vector<Shard> shards(shardCount);
+    for (std::size_t i = 0; i < shardCount; ++i) {
+        shards[i].begin = begin + (end - begin) * i / shardCount;
+        shards[i].limit = begin + (end - begin) * (i + 1) / shardCount;
+    }
+
+    parallelFor(shardCount, threadCount, [&](std::size_t i) {
+        auto &shard = shards[i];
+        shard.visited.resize(shard.limit - shard.begin);
+
+        shard.stop = architecture_->createDisassembler()->sweep(image, source, shard.begin, shard.limit, end,
+            [&](std::unique_ptr<Instruction> instruction) { shard.instructions.push_back(std::move(instruction)); },
+            [&](ByteAddr pc) { shard.visited[pc - shard.begin] = true; return true; },
+            canceled);
+    });
+
+    /*
+     * Merge the shards. A linear sweep over the whole range would enter
+     * each shard at some address. If the shard's own sweep went through
+     * this address, the rest of the two sweeps coincide. Otherwise, we
+     * continue the sweep from the entry address until it meets the
+     * shard's sweep, which normally takes a few instructions.
+     */
+    ByteAddr pc = begin;
+    foreach (auto &shard, shards) {
+        if (pc >= shard.limit) {
+            shard.instructions.clear();
+            continue;
+        }
+
+        if (!shard.visited[pc - shard.begin]) {
+            pc = sweep(image, source, pc, shard.limit, end, callback,
+                [&](ByteAddr address) { return !shard.visited[address - shard.begin]; },
+                canceled);
+
+            if (pc >= shard.limit) {
+                shard.instructions.clear();
+                continue;
+            }
+        }
+
+        foreach (auto &instruction, shard.instructions) {
+            if (instruction->addr() >= pc) {
+                callback(std::move(instruction));
+            }
+        }
+        shard.instructions.clear();
+
+        pc = shard.stop;
+    }
 }
 
-std::shared_ptr<Instruction> Disassembler::disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source) {
+std::unique_ptr<Instruction> Disassembler::disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source) {
     const SmallByteSize maxInstructionSize = architecture_->maxInstructionSize();
     const std::unique_ptr<char[]> buffer(new char[maxInstructionSize]);
 
@@ -50,7 +50,7 @@ public:
      */
     virtual ~Disassembler() {}
 
-    typedef std::function<void(std::shared_ptr<Instruction>)> InstructionCallback;
+    typedef std::function<void(std::unique_ptr<Instruction>)> InstructionCallback;
 
     /**
      * Disassembles all instructions in the given range of addresses.
@@ -63,6 +63,22 @@ public:
      */
     virtual void disassemble(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, const InstructionCallback &callback, const CancellationToken &canceled);
 
+    /**
+     * Disassembles all instructions in the given range of addresses, possibly
+     * using several threads. The range is split into shards disassembled
+     * independently, which are then resynchronized at their boundaries.
+     * The result is the same as the one of the single-threaded version.
+     *
+     * \param source Valid pointer to a byte source.
+     * \param begin First address in the range.
+     * \param end First address past the range.
+     * \param callback Function being called for each disassembled instruction,
+     *                 in the calling thread, in the order of addresses.
+     * \param threadCount Maximal number of threads to use.
+     * \param canceled Cancellation token.
+     */
+    void disassemble(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr end, const InstructionCallback &callback, int threadCount, const CancellationToken &canceled);
+
     /**
      * Disassembles a single instruction.
      *
@@ -72,7 +88,7 @@ public:
      *
      * \return Pointer to the instruction disassembled from the buffer if disassembling succeeded, nullptr otherwise.
      */
-    virtual std::shared_ptr<Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) = 0;
+    virtual std::unique_ptr<Instruction> disassembleSingleInstruction(ByteAddr pc, const void *buffer, ByteSize size) = 0;
 
     /**
      * Disassembles a single instruction.
@@ -82,7 +98,26 @@ public:
      *
      * \return Pointer to the instruction disassembled from the buffer if disassembling succeeded, nullptr otherwise.
      */
-    virtual std::shared_ptr<Instruction> disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source);
+    virtual std::unique_ptr<Instruction> disassembleSingleInstruction(ByteAddr pc, const image::ByteSource *source);
+
+private:
+    /**
+     * Performs a linear sweep starting at the given address.
+     *
+     * \param image Valid pointer to the image whose relocations are taken into account.
+     * \param source Valid pointer to a byte source.
+     * \param begin Address to start from.
+     * \param limit The sweep stops when the address of the next instruction is not less than this one.
+     * \param end First address past the range of addresses that may be read. Must be not less than limit.
+     * \param callback Function being called for each disassembled instruction.
+     * \param visit If set, it is called for each address the sweep goes through.
+     *              The sweep stops at the address for which it returns false.
+     * \param canceled Cancellation token.
+     *
+     * \return Address at which the sweep has stopped.
+     */
+    ByteAddr sweep(const image::Image *image, const image::ByteSource *source, ByteAddr begin, ByteAddr limit, ByteAddr end,
+        const InstructionCallback &callback, const std::function<bool(ByteAddr)> &visit, const CancellationToken &canceled);
 };
 
 } // namespace arch
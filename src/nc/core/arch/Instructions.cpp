@@ -24,6 +24,8 @@
 
 #include "Instructions.h"
 
+#include <algorithm>
+
 #include <QTextStream>
 
 #include <nc/common/Foreach.h>
@@ -32,37 +34,169 @@ namespace nc {
 namespace core {
 namespace arch {
 
-const std::shared_ptr<const Instruction> &Instructions::getCovering(ByteAddr addr) const {
-    auto i = address2instruction_.lower_bound(addr);
+namespace {
+
+bool addrLess(const Instruction *a, const Instruction *b) {
+    return a->addr() < b->addr();
+}
+
+bool addrLessThan(const Instruction *a, ByteAddr addr) {
+    return a->addr() < addr;
+}
+
+bool addrGreaterThan(ByteAddr addr, const Instruction *a) {
+    return addr < a->addr();
+}
+
+} // anonymous namespace
 
-    if (i != address2instruction_.end() &&
-        i->second->addr() <= addr && addr < i->second->endAddr())
-    {
-        return i->second;
+Instructions::Instructions():
+    instructions_(std::make_shared<InstructionsRange>()),
+    nremoved_(0)
+{}
+
+const Instruction *Instructions::get(ByteAddr addr) const {
+    auto i = std::lower_bound(all().begin(), all().end(), addr, addrLessThan);
+
+    if (i != all().end() && (*i)->addr() == addr) {
+        return *i;
     } else {
-        static const std::shared_ptr<const Instruction> null;
-        return null;
+        return nullptr;
     }
 }
 
-bool Instructions::add(std::shared_ptr<const Instruction> instruction) {
-    assert(instruction != nullptr);
+const Instruction *Instructions::getCovering(ByteAddr addr) const {
+    auto i = std::upper_bound(all().begin(), all().end(), addr, addrGreaterThan);
 
-    auto &existing = address2instruction_[instruction->addr()];
-    if (!existing) {
-        existing = std::move(instruction);
-        return true;
+    if (i != all().begin() && addr < (*--i)->endAddr()) {
+        return *i;
     } else {
+        return nullptr;
+    }
+}
+
+bool Instructions::add(std::unique_ptr<const Instruction> instruction) {
+    assert(instruction != nullptr);
+
+    auto &instructions = modifiableInstructions();
+
+    auto i = std::lower_bound(instructions.begin(), instructions.end(), instruction->addr(), addrLessThan);
+    if (i != instructions.end() && (*i)->addr() == instruction->addr()) {
         return false;
     }
+
+    instructions.insert(i, instruction.get());
+    modifiableBatch().push_back(std::move(instruction));
+    return true;
+}
+
+void Instructions::add(std::vector<std::unique_ptr<const Instruction>> instructions) {
+    if (instructions.empty()) {
+        return;
+    }
+
+    auto less = [](const std::unique_ptr<const Instruction> &a, const std::unique_ptr<const Instruction> &b) {
+        return addrLess(a.get(), b.get());
+    };
+    if (!std::is_sorted(instructions.begin(), instructions.end(), less)) {
+        std::stable_sort(instructions.begin(), instructions.end(), less);
+    }
+
+    const auto &existing = all();
+
+    auto merged = std::make_shared<InstructionsRange>();
+    merged->reserve(existing.size() + instructions.size());
+
+    auto batch = std::make_shared<Batch>();
+    batch->reserve(instructions.size());
+
+    auto i = existing.begin();
+    foreach (auto &instruction, instructions) {
+        assert(instruction != nullptr);
+
+        while (i != existing.end() && (*i)->addr() < instruction->addr()) {
+            merged->push_back(*i++);
+        }
+
+        if ((i != existing.end() && (*i)->addr() == instruction->addr()) ||
+            (!merged->empty() && merged->back()->addr() == instruction->addr())) {
+            continue;
+        }
+
+        merged->push_back(instruction.get());
+        batch->push_back(std::move(instruction));
+    }
+    merged->insert(merged->end(), i, existing.end());
+
+    instructions_ = std::move(merged);
+    if (!batch->empty()) {
+        batches_.push_back(std::move(batch));
+    }
 }
 
 bool Instructions::remove(const Instruction *instruction) {
-    if (get(instruction->addr()).get() == instruction) {
-        return address2instruction_.erase(instruction->addr());
-    } else {
+    if (get(instruction->addr()) != instruction) {
         return false;
     }
+
+    auto &instructions = modifiableInstructions();
+    instructions.erase(std::lower_bound(instructions.begin(), instructions.end(), instruction->addr(), addrLessThan));
+    onRemoved(1);
+    return true;
+}
+
+void Instructions::removeIf(const std::function<bool(const Instruction *)> &pred) {
+    auto i = std::find_if(all().begin(), all().end(), pred);
+    if (i == all().end()) {
+        return;
+    }
+
+    auto first = i - all().begin();
+
+    auto &instructions = modifiableInstructions();
+    auto oldSize = instructions.size();
+    instructions.erase(std::remove_if(instructions.begin() + first, instructions.end(), pred), instructions.end());
+    onRemoved(oldSize - instructions.size());
+}
+
+Instructions::InstructionsRange &Instructions::modifiableInstructions() {
+    if (instructions_.use_count() != 1) {
+        instructions_ = std::make_shared<InstructionsRange>(*instructions_);
+    }
+    return *instructions_;
+}
+
+Instructions::Batch &Instructions::modifiableBatch() {
+    if (batches_.empty() || batches_.back().use_count() != 1) {
+        batches_.push_back(std::make_shared<Batch>());
+    }
+    return *batches_.back();
+}
+
+void Instructions::onRemoved(std::size_t count) {
+    nremoved_ += count;
+    if (nremoved_ > size()) {
+        compact();
+    }
+}
+
+void Instructions::compact() {
+    auto removed = [this](const std::unique_ptr<const Instruction> &instruction) {
+        return get(instruction->addr()) != instruction.get();
+    };
+
+    foreach (auto &batch, batches_) {
+        /* Instructions of a shared batch may still be in other sets. */
+        if (batch.use_count() == 1) {
+            batch->erase(std::remove_if(batch->begin(), batch->end(), removed), batch->end());
+        }
+    }
+
+    batches_.erase(std::remove_if(batches_.begin(), batches_.end(),
+                                  [](const std::shared_ptr<Batch> &batch) { return batch->empty(); }),
+                   batches_.end());
+
+    nremoved_ = 0;
 }
 
 void Instructions::print(QTextStream &out, PrintCallback<const Instruction *> *callback) const {
@@ -79,7 +213,7 @@ void Instructions::print(QTextStream &out, PrintCallback<const Instruction *> *c
         successorAddress = instr->endAddr();
 
         if (callback) {
-            callback->onStartPrinting(instr.get());
+            callback->onStartPrinting(instr);
         }
 
         int integerBase = out.integerBase();
@@ -90,7 +224,7 @@ void Instructions::print(QTextStream &out, PrintCallback<const Instruction *> *c
         out << *instr;
 
         if (callback) {
-            callback->onEndPrinting(instr.get());
+            callback->onEndPrinting(instr);
         }
 
         out << '\n';
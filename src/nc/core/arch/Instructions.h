@@ -25,13 +25,11 @@
 
 #include <nc/config.h>
 
-#include <map>
-#include <memory> /* std::shared_ptr */
-
-#include <boost/range/adaptor/map.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
 
 #include <nc/common/PrintCallback.h>
-#include <nc/common/Range.h> /* nc::find */
 
 #include "Instruction.h"
 
@@ -41,22 +39,43 @@ class Instruction;
 
 /**
  * Class representing a set of instructions.
+ *
+ * Instructions are kept in a vector sorted by their addresses.
+ * The vector is shared between copies of the set until one of them
+ * is modified, so copying a set is cheap. The instruction objects
+ * are owned by batches, which are shared between all the copies
+ * that the instructions of a batch have been added to. Removed
+ * instructions are freed once no other copy shares their batch
+ * and enough of them have accumulated.
  */
 class Instructions {
-    /** Type of mapping of addresses to instruction. */
-    typedef std::map<ByteAddr, std::shared_ptr<const Instruction>> AddressInstructionMap;
+public:
+    /** Type of a range of instructions sorted by their addresses in ascending order. */
+    typedef std::vector<const Instruction *> InstructionsRange;
+
+private:
+    /** Type of a group of instruction objects owned together. */
+    typedef std::vector<std::unique_ptr<const Instruction>> Batch;
 
-    /** Mapping of addresses to instructions. */
-    AddressInstructionMap address2instruction_;
+    /** Instructions sorted by their addresses. */
+    std::shared_ptr<InstructionsRange> instructions_;
+
+    /** Batches owning the instructions of this set and possibly some removed ones. */
+    std::vector<std::shared_ptr<Batch>> batches_;
+
+    /** Number of instructions removed since the last compaction of the batches. */
+    std::size_t nremoved_;
 
 public:
-    /** Type for the sorted range of instructions. */
-    typedef boost::select_second_const_range<AddressInstructionMap> InstructionsRange;
+    /**
+     * Constructs an empty set.
+     */
+    Instructions();
 
     /**
      * \return Range of instructions sorted by their addresses in ascending order.
      */
-    InstructionsRange all() const { return address2instruction_ | boost::adaptors::map_values; }
+    const InstructionsRange &all() const { return *instructions_; }
 
     /**
      * \param[in] addr Address.
@@ -64,24 +83,38 @@ public:
      * \return Pointer to the instruction starting at the given address.
      *         Can be nullptr, if there is no such instructions.
      */
-    const std::shared_ptr<const Instruction> &get(ByteAddr addr) const { return nc::find(address2instruction_, addr); }
+    const Instruction *get(ByteAddr addr) const;
 
     /**
      * \param[in] addr Address.
      *
      * \return Pointer to the instruction covering the given address.
-     *         Can be nullptr, if there are no instructions.
+     *         Can be nullptr, if there is no such instruction.
      */
-    const std::shared_ptr<const Instruction> &getCovering(ByteAddr addr) const;
+    const Instruction *getCovering(ByteAddr addr) const;
 
     /**
      * Adds instruction if there is no instruction with the given address yet.
      *
+     * Adding an instruction with an address greater than the addresses
+     * of all instructions in the set takes amortized constant time.
+     * Otherwise, the time is linear in the size of the set.
+     *
      * \param instruction Valid pointer to an instruction.
      *
      * \return True if the instruction was added, false otherwise.
      */
-    bool add(std::shared_ptr<const Instruction> instruction);
+    bool add(std::unique_ptr<const Instruction> instruction);
+
+    /**
+     * Adds instructions whose addresses are not occupied yet.
+     * If several given instructions have the same address, the first of them is added.
+     * The time is linear in the total number of instructions, if the given
+     * instructions are sorted by their addresses.
+     *
+     * \param instructions Valid pointers to instructions.
+     */
+    void add(std::vector<std::unique_ptr<const Instruction>> instructions);
 
     /**
      * Deletes given instruction from the set.
@@ -92,10 +125,17 @@ public:
      */
     bool remove(const Instruction *instruction);
 
+    /**
+     * Deletes all instructions satisfying the given predicate from the set.
+     *
+     * \param pred Predicate.
+     */
+    void removeIf(const std::function<bool(const Instruction *)> &pred);
+
     /**
      * \return Number of instructions in the set.
      */
-    std::size_t size() const { return address2instruction_.size(); }
+    std::size_t size() const { return instructions_->size(); }
 
     /**
      * \return True if the set is empty, false is otherwise.
@@ -109,6 +149,30 @@ public:
      * \param callback Pointer to the print callback. Can be nullptr.
      */
     void print(QTextStream &out, PrintCallback<const Instruction *> *callback = nullptr) const;
+
+private:
+    /**
+     * \return Modifiable sorted vector of instructions, not shared with other sets.
+     */
+    InstructionsRange &modifiableInstructions();
+
+    /**
+     * \return Batch for adding new instructions, not shared with other sets.
+     */
+    Batch &modifiableBatch();
+
+    /**
+     * Accounts for the given number of removed instructions and frees
+     * the removed instructions if they outnumber the ones in the set.
+     *
+     * \param count Number of instructions just removed.
+     */
+    void onRemoved(std::size_t count);
+
+    /**
+     * Frees the removed instructions owned by batches not shared with other sets.
+     */
+    void compact();
 };
 
 }}} // namespace nc::core::arch
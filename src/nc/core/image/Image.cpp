@@ -24,7 +24,11 @@
 
 #include "Image.h"
 
+#include <algorithm>
+#include <set>
+
 #include <nc/common/Foreach.h>
+#include <nc/common/ParallelFor.h>
 #include <nc/common/Range.h>
 #include <nc/common/make_unique.h>
 
@@ -37,7 +41,10 @@
 namespace nc { namespace core { namespace image {
 
 Image::Image():
-    demangler_(new mangling::DefaultDemangler())
+    demangler_(new mangling::DefaultDemangler()),
+    sectionIndexValid_(false),
+    lastSectionRange_(nullptr),
+    sortedRelocationsValid_(false)
 {}
 
 Image::~Image() {}
@@ -45,17 +52,93 @@ Image::~Image() {}
 void Image::addSection(std::unique_ptr<Section> section) {
     assert(section != nullptr);
     sections_.push_back(std::move(section));
+
+    sectionIndexValid_ = false;
+    lastSectionRange_ = nullptr;
 }
 
 const Section *Image::getSectionContainingAddress(ByteAddr addr) const {
-    foreach (auto section, sections()) {
-        if (section->isAllocated() && section->containsAddress(addr)) {
-            return section;
-        }
+    if (auto range = getSectionRange(addr)) {
+        return range->section;
     }
     return nullptr;
 }
 
+const Image::SectionRange *Image::getSectionRange(ByteAddr addr) const {
+    if (!sectionIndexValid_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(sectionIndexMutex_);
+        if (!sectionIndexValid_.load(std::memory_order_relaxed)) {
+            buildSectionIndex();
+            sectionIndexValid_.store(true, std::memory_order_release);
+        }
+    }
+
+    /* Consecutive reads tend to hit the same section. */
+    auto last = lastSectionRange_.load(std::memory_order_relaxed);
+    if (last && last->begin <= addr && addr < last->end) {
+        return last;
+    }
+
+    auto i = std::upper_bound(sectionIndex_.begin(), sectionIndex_.end(), addr,
+        [](ByteAddr a, const SectionRange &range) { return a < range.begin; });
+    if (i == sectionIndex_.begin()) {
+        return nullptr;
+    }
+    --i;
+    if (addr >= i->end) {
+        return nullptr;
+    }
+
+    lastSectionRange_.store(&*i, std::memory_order_relaxed);
+    return &*i;
+}
+
+void Image::buildSectionIndex() const {
+    sectionIndex_.clear();
+
+    /*
+     * Sections may overlap. Sweep over the boundaries of the sections,
+     * keeping the set of sections covering the current address,
+     * identified by their positions in the list of sections.
+     */
+    std::vector<std::pair<ByteAddr, std::size_t>> boundaries;
+    for (std::size_t i = 0; i < sections_.size(); ++i) {
+        const Section *section = sections_[i].get();
+        if (section->isAllocated() && section->size() > 0) {
+            boundaries.push_back(std::make_pair(section->addr(), i));
+            boundaries.push_back(std::make_pair(section->addr() + section->size(), i));
+        }
+    }
+    std::sort(boundaries.begin(), boundaries.end(),
+        [](const std::pair<ByteAddr, std::size_t> &a, const std::pair<ByteAddr, std::size_t> &b) {
+            return a.first < b.first;
+        });
+
+    std::set<std::size_t> covering;
+    for (std::size_t i = 0; i < boundaries.size();) {
+        ByteAddr addr = boundaries[i].first;
+
+        /* Each section has two boundaries: the first one opens it, the second one closes. */
+        for (; i < boundaries.size() && boundaries[i].first == addr; ++i) {
+            auto j = covering.find(boundaries[i].second);
+            if (j == covering.end()) {
+                covering.insert(boundaries[i].second);
+            } else {
+                covering.erase(j);
+            }
+        }
+
+        if (!covering.empty() && i < boundaries.size()) {
+            const Section *section = sections_[*covering.begin()].get();
+            if (!sectionIndex_.empty() && sectionIndex_.back().section == section && sectionIndex_.back().end == addr) {
+                sectionIndex_.back().end = boundaries[i].first;
+            } else {
+                sectionIndex_.push_back(SectionRange{addr, boundaries[i].first, section});
+            }
+        }
+    }
+}
+
 const Section *Image::getSectionByName(const QString &name) const {
     foreach (auto section, sections()) {
         if (section->name() == name) {
@@ -66,11 +149,24 @@ const Section *Image::getSectionByName(const QString &name) const {
 }
 
 ByteSize Image::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
-    if (const Section *section = getSectionContainingAddress(addr)) {
-        return section->readBytes(addr, buf, size);
-    } else {
-        return 0;
+    ByteSize result = 0;
+
+    while (result < size) {
+        auto range = getSectionRange(addr + result);
+        if (!range) {
+            break;
+        }
+
+        auto chunkSize = std::min(size - result, range->end - (addr + result));
+        auto readSize = range->section->readBytes(addr + result, static_cast<char *>(buf) + result, chunkSize);
+
+        result += readSize;
+        if (readSize < chunkSize) {
+            break;
+        }
     }
+
+    return result;
 }
 
 const Symbol *Image::addSymbol(std::unique_ptr<Symbol> symbol) {
@@ -95,6 +191,8 @@ const Relocation *Image::addRelocation(std::unique_ptr<Relocation> relocation) {
     relocations_.push_back(std::move(relocation));
     address2relocation_[result->address()] = result;
 
+    sortedRelocationsValid_ = false;
+
     return result;
 }
 
@@ -102,10 +200,65 @@ const Relocation *Image::getRelocation(ByteAddr address) const {
     return nc::find(address2relocation_, address);
 }
 
+const std::vector<const Relocation *> &Image::sortedRelocations() const {
+    if (!sortedRelocationsValid_.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(sortedRelocationsMutex_);
+        if (!sortedRelocationsValid_.load(std::memory_order_relaxed)) {
+            sortedRelocations_.clear();
+            sortedRelocations_.reserve(address2relocation_.size());
+            foreach (const auto &addressAndRelocation, address2relocation_) {
+                sortedRelocations_.push_back(addressAndRelocation.second);
+            }
+            std::sort(sortedRelocations_.begin(), sortedRelocations_.end(),
+                [](const Relocation *a, const Relocation *b) { return a->address() < b->address(); });
+
+            sortedRelocationsValid_.store(true, std::memory_order_release);
+        }
+    }
+    return sortedRelocations_;
+}
+
 void Image::setDemangler(std::unique_ptr<mangling::Demangler> demangler) {
     assert(demangler != nullptr);
 
     demangler_ = std::move(demangler);
+
+    std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+    demangledNames_.clear();
+}
+
+QString Image::getDemangledName(const Symbol *symbol) const {
+    assert(symbol != nullptr);
+
+    {
+        std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+
+        auto i = demangledNames_.find(symbol);
+        if (i != demangledNames_.end()) {
+            return i->second;
+        }
+    }
+
+    /* Demangle outside the lock: demangling is the expensive part. */
+    auto result = demangler_->demangle(symbol->name());
+
+    std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+    demangledNames_[symbol] = result;
+
+    return result;
+}
+
+void Image::demangleSymbols(int threadCount) const {
+    std::vector<QString> names(symbols_.size());
+
+    parallelFor(symbols_.size(), threadCount, [&](std::size_t i) {
+        names[i] = demangler_->demangle(symbols_[i]->name());
+    });
+
+    std::lock_guard<std::mutex> lock(demangledNamesMutex_);
+    for (std::size_t i = 0; i < symbols_.size(); ++i) {
+        demangledNames_[symbols_[i].get()] = std::move(names[i]);
+    }
 }
 
 }}} // namespace nc::core::image
@@ -25,7 +25,10 @@
 
 #include <nc/config.h>
 
+#include <atomic>
+#include <cassert>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
@@ -48,6 +51,7 @@ namespace mangling {
 
 namespace image {
 
+class MappedFile;
 class Section;
 class Relocation;
 
@@ -56,14 +60,39 @@ class Relocation;
  */
 class Image: public ByteSource {
     Platform platform_;
+    std::vector<std::shared_ptr<const MappedFile>> mappedFiles_; ///< Memory-mapped input files.
     std::vector<std::unique_ptr<Section>> sections_; ///< The list of sections.
     std::vector<std::unique_ptr<Symbol>> symbols_; ///< The list of symbols.
     boost::unordered_map<ConstantValue, Symbol *> value2symbol_; ///< Mapping from value to the symbol with this value.
     std::vector<std::unique_ptr<Relocation>> relocations_; ///< The list of relocations.
     boost::unordered_map<ByteAddr, Relocation *> address2relocation_; ///< Mapping from an address to the relocation with this address.
     std::unique_ptr<mangling::Demangler> demangler_; ///< Demangler.
+    mutable boost::unordered_map<const Symbol *, QString> demangledNames_; ///< Cached demangled names of symbols.
+    mutable std::mutex demangledNamesMutex_; ///< Mutex guarding demangledNames_.
     boost::optional<ByteAddr> entrypoint_; ///< Entrypoint of image.
 
+    /**
+     * Range of addresses belonging to an allocated section.
+     */
+    struct SectionRange {
+        ByteAddr begin; ///< First address of the range.
+        ByteAddr end; ///< Address following the last address of the range.
+        const Section *section; ///< Valid pointer to the section.
+    };
+
+    /**
+     * Disjoint ranges of addresses ordered by address. Each range is mapped
+     * to the first added allocated section containing these addresses.
+     */
+    mutable std::vector<SectionRange> sectionIndex_;
+    mutable std::atomic<bool> sectionIndexValid_; ///< True if sectionIndex_ is up to date.
+    mutable std::mutex sectionIndexMutex_; ///< Mutex guarding the construction of sectionIndex_.
+    mutable std::atomic<const SectionRange *> lastSectionRange_; ///< Range found by the last lookup. Can be nullptr.
+
+    mutable std::vector<const Relocation *> sortedRelocations_; ///< Relocations ordered by address, one per address.
+    mutable std::atomic<bool> sortedRelocationsValid_; ///< True if sortedRelocations_ is up to date.
+    mutable std::mutex sortedRelocationsMutex_; ///< Mutex guarding the construction of sortedRelocations_.
+
 public:
     /**
      * Constructor.
@@ -111,6 +140,9 @@ public:
      *
      * \return A valid pointer to allocated section containing given
      *         virtual address or nullptr if there is no such section.
+     *
+     * \note The lookup takes logarithmic time and is thread-safe.
+     *       Sections must not be moved or resized after the first lookup.
      */
     const Section *getSectionContainingAddress(ByteAddr addr) const;
 
@@ -123,8 +155,9 @@ public:
     const Section *getSectionByName(const QString &name) const;
 
     /**
-     * Reads a sequence of bytes from the section containing
-     * the given address and allocated during program execution.
+     * Reads a sequence of bytes from the sections allocated during program
+     * execution. The read continues into the following section if it is
+     * adjacent to the previous one.
      */
     ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
 
@@ -169,6 +202,17 @@ public:
      */
     const Relocation *getRelocation(ByteAddr address) const;
 
+    /**
+     * \return Relocations ordered by address, at most one per address:
+     *         the one returned by getRelocation() for this address.
+     *         Use RelocationCursor for walking it in step with an address.
+     *         The vector is rebuilt by the next call after addRelocation(),
+     *         so references to it must not be kept across adding relocations.
+     *
+     * \note This function is thread-safe.
+     */
+    const std::vector<const Relocation *> &sortedRelocations() const;
+
     /**
      * \return Valid pointer to a demangler.
      */
@@ -181,6 +225,24 @@ public:
      */
     void setDemangler(std::unique_ptr<mangling::Demangler> demangler);
 
+    /**
+     * Demangles the name of the symbol using the image's demangler.
+     * The result is cached, so that every name is demangled only once.
+     * This function is thread-safe.
+     *
+     * \param symbol Valid pointer to a symbol.
+     *
+     * \return Demangled name, or QString() if the name could not be demangled.
+     */
+    QString getDemangledName(const Symbol *symbol) const;
+
+    /**
+     * Demangles the names of all the symbols of the image in advance.
+     *
+     * \param threadCount Number of threads to use.
+     */
+    void demangleSymbols(int threadCount) const;
+
     /**
      * Sets the entry point address.
      *
@@ -192,6 +254,31 @@ public:
      * \return Address of the entry point.
      */
     const boost::optional<ByteAddr> &entrypoint() const { return entrypoint_; }
+
+    /**
+     * Adds a memory-mapped input file. The image keeps all its files mapped,
+     * so that the contents of its sections can reference the mapped memory.
+     *
+     * \param mappedFile Valid pointer to the mapped file.
+     */
+    void addMappedFile(std::shared_ptr<const MappedFile> mappedFile) {
+        assert(mappedFile != nullptr);
+        mappedFiles_.push_back(std::move(mappedFile));
+    }
+
+private:
+    /**
+     * \param[in] addr Linear address.
+     *
+     * \return Pointer to the range of the section index containing
+     *         the given address. Can be nullptr.
+     */
+    const SectionRange *getSectionRange(ByteAddr addr) const;
+
+    /**
+     * Builds the index of allocated sections.
+     */
+    void buildSectionIndex() const;
 };
 
 }}} // namespace nc::core::image
@@ -0,0 +1,56 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+namespace nc {
+namespace core {
+namespace image {
+
+MappedFile::MappedFile(const QString &filename):
+    file_(filename), data_(nullptr), size_(0)
+{}
+
+MappedFile::~MappedFile() {}
+
+bool MappedFile::open() {
+    if (!file_.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    auto size = file_.size();
+    if (size > 0 && size <= std::numeric_limits<int>::max()) {
+        if (auto data = file_.map(0, size)) {
+            data_ = reinterpret_cast<const char *>(data);
+            size_ = size;
+        }
+    }
+
+    return true;
+}
+
+boost::optional<QByteArray> MappedFile::bytes(ByteSize offset, ByteSize size) const {
+    if (!isMapped() || offset < 0 || offset > size_ || size < 0) {
+        return boost::none;
+    }
+    return QByteArray::fromRawData(data_ + offset, static_cast<int>(std::min(size, size_ - offset)));
+}
+
+ByteSize MappedFile::readBytes(ByteAddr addr, void *buf, ByteSize size) const {
+    if (!isMapped() || addr < 0 || addr >= size_ || size <= 0) {
+        return 0;
+    }
+    auto copiedSize = std::min(size, size_ - addr);
+    memcpy(buf, data_ + addr, copiedSize);
+    return copiedSize;
+}
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -0,0 +1,85 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <boost/noncopyable.hpp>
+#include <boost/optional.hpp>
+
+#include <QByteArray>
+#include <QFile>
+
+#include "ByteSource.h"
+
+namespace nc {
+namespace core {
+namespace image {
+
+/**
+ * Input file mapped into memory.
+ *
+ * Addresses of this byte source are offsets in the file.
+ * Byte arrays returned by bytes() reference the mapped memory
+ * and stay valid as long as the mapped file exists.
+ */
+class MappedFile: public ByteSource, boost::noncopyable {
+    QFile file_; ///< The file.
+    const char *data_; ///< Mapped contents of the file. Can be nullptr.
+    ByteSize size_; ///< Size of the mapped contents.
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param filename Name of the file.
+     */
+    explicit MappedFile(const QString &filename);
+
+    /**
+     * Destructor.
+     */
+    ~MappedFile();
+
+    /**
+     * Opens the file for reading and maps it into memory.
+     *
+     * \return True if the file was opened, false otherwise.
+     *         Failing to map an opened file is not an error: isMapped() tells whether it succeeded.
+     */
+    bool open();
+
+    /**
+     * \return The file as an IO device.
+     */
+    QIODevice *device() { return &file_; }
+
+    /**
+     * \return True if the contents of the file are mapped into memory.
+     */
+    bool isMapped() const { return data_ != nullptr; }
+
+    /**
+     * \return Size of the mapped contents.
+     */
+    ByteSize size() const { return size_; }
+
+    /**
+     * \param offset Offset of the first byte in the file.
+     * \param size Number of bytes.
+     *
+     * \return Byte array referencing the mapped bytes without copying them.
+     *         The array is shorter than requested if the file ends earlier.
+     *         boost::none if the file is not mapped or the offset is past its end.
+     */
+    boost::optional<QByteArray> bytes(ByteSize offset, ByteSize size) const;
+
+    ByteSize readBytes(ByteAddr addr, void *buf, ByteSize size) const override;
+};
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
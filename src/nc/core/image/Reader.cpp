@@ -24,6 +24,8 @@
 
 #include "Reader.h"
 
+#include <memory>
+
 #include <QString>
 
 namespace nc {
@@ -27,8 +27,9 @@
 
 #include <algorithm>
 #include <cassert>
-#include <cstring> /* memset */
-#include <memory>
+#include <climits> /* CHAR_BIT */
+#include <type_traits>
+#include <vector>
 
 #include <boost/optional.hpp>
 
@@ -89,21 +90,64 @@ public:
         assert(size >= 0);
         assert(byteOrder != ByteOrder::Unknown);
 
-        std::unique_ptr<char[]> buf(new char[std::max<std::size_t>(size, sizeof(T))]);
+        /* Integers are small: avoid going to the heap for them. */
+        unsigned char buf[16];
+        if (static_cast<std::size_t>(size) > sizeof(buf)) {
+            std::vector<unsigned char> bigBuf(size);
+            if (readBytes(addr, bigBuf.data(), size) != size) {
+                return boost::none;
+            }
+            return decodeInt<T>(bigBuf.data(), size, byteOrder);
+        }
 
-        if (readBytes(addr, buf.get(), size) != size) {
+        if (readBytes(addr, buf, size) != size) {
             return boost::none;
         }
+        return decodeInt<T>(buf, size, byteOrder);
+    }
 
-        ByteOrder::convert(buf.get(), size, byteOrder, ByteOrder::LittleEndian);
+    /**
+     * Reads an array of integer values, e.g. a table of pointers.
+     *
+     * \param[in] addr      Address of the first element.
+     * \param[in] size      Size of each element.
+     * \param[in] count     Number of elements to read.
+     * \param[in] byteOrder Byte order used for storing the elements.
+     * \param[in] stride    Distance between the addresses of consecutive elements.
+     *                      Zero means that the elements are stored without gaps.
+     *
+     * \tparam T Type of the elements in the result, see readInt().
+     *
+     * \return Values of the elements, in the order of increasing addresses.
+     *         If not all the elements can be read, the elements preceding
+     *         the first unreadable one are returned.
+     */
+    template<class T>
+    std::vector<T> readArray(ByteAddr addr, ByteSize size, std::size_t count, ByteOrder byteOrder, ByteSize stride = 0) const {
+        assert(size > 0);
+        assert(stride >= 0);
+        assert(byteOrder != ByteOrder::Unknown);
+
+        if (stride == 0) {
+            stride = size;
+        }
 
-        if (static_cast<std::size_t>(size) < sizeof(T)) {
-            memset(buf.get() + size, 0, sizeof(T) - size);
+        std::vector<T> result;
+        if (count == 0) {
+            return result;
         }
 
-        ByteOrder::convert(buf.get(), sizeof(T), ByteOrder::LittleEndian, ByteOrder::Current);
+        std::vector<unsigned char> buf((count - 1) * stride + size);
+        ByteSize bytesRead = readBytes(addr, buf.data(), buf.size());
+
+        if (bytesRead >= size) {
+            result.reserve(std::min<std::size_t>(count, (bytesRead - size) / stride + 1));
+            for (ByteSize offset = 0; offset + size <= bytesRead && result.size() < count; offset += stride) {
+                result.push_back(decodeInt<T>(buf.data() + offset, size, byteOrder));
+            }
+        }
 
-        return *reinterpret_cast<T *>(buf.get());
+        return result;
     }
 
     /**
@@ -115,6 +159,39 @@ public:
      * \return ASCIIZ string without zero char terminator on success, nullptr string on failure.
      */
     QString readAsciizString(ByteAddr addr, ByteSize maxSize) const;
+
+private:
+    /**
+     * Decodes an integer value.
+     *
+     * \param[in] bytes     Valid pointer to the bytes of the value.
+     * \param[in] size      Size of the integer value.
+     * \param[in] byteOrder Byte order used for storing the integer value.
+     *
+     * \tparam T Result type.
+     *
+     * \return The integer value, truncated or zero-extended as in readInt().
+     */
+    template<class T>
+    static T decodeInt(const unsigned char *bytes, ByteSize size, ByteOrder byteOrder) {
+        typedef typename std::make_unsigned<T>::type UnsignedT;
+
+        UnsignedT result = 0;
+        auto count = std::min<std::size_t>(size, sizeof(T));
+
+        /* The lower bytes go first in little endian and last in big endian. */
+        if (byteOrder == ByteOrder::LittleEndian) {
+            for (std::size_t i = 0; i < count; ++i) {
+                result |= static_cast<UnsignedT>(bytes[i]) << (i * CHAR_BIT);
+            }
+        } else {
+            for (std::size_t i = 0; i < count; ++i) {
+                result |= static_cast<UnsignedT>(bytes[size - 1 - i]) << (i * CHAR_BIT);
+            }
+        }
+
+        return static_cast<T>(result);
+    }
 };
 
 } // namespace image
@@ -0,0 +1,88 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+#include "Image.h"
+#include "Relocation.h"
+
+namespace nc {
+namespace core {
+namespace image {
+
+/**
+ * Cursor over the relocations of an image ordered by address.
+ *
+ * Looking up the relocations at increasing addresses, e.g. while sweeping
+ * over a section, costs a comparison, plus a binary search over the rest
+ * of the relocations each time the cursor passes one. No hashing is done.
+ * Going backwards is allowed, but costs a binary search.
+ * Each thread must use a cursor of its own.
+ *
+ * The cursor refers to Image::sortedRelocations(), so no relocations
+ * may be added to the image while the cursor is in use.
+ */
+class RelocationCursor {
+    const std::vector<const Relocation *> *relocations_; ///< Relocations ordered by address.
+    std::size_t index_; ///< Index of the first relocation with address not less than the last looked up one.
+
+public:
+    /**
+     * Constructor.
+     *
+     * \param image Valid pointer to the image.
+     */
+    explicit RelocationCursor(const Image *image):
+        index_(0)
+    {
+        assert(image != nullptr);
+        relocations_ = &image->sortedRelocations();
+    }
+
+    /**
+     * Moves the cursor to the given address.
+     *
+     * \param address Virtual address.
+     *
+     * \return Pointer to the relocation at the given address. Can be nullptr.
+     */
+    const Relocation *getRelocation(ByteAddr address) {
+        const auto &relocations = *relocations_;
+
+        if (index_ > 0 && relocations[index_ - 1]->address() >= address) {
+            index_ = lowerBound(0, address);
+        } else if (index_ < relocations.size() && relocations[index_]->address() < address) {
+            index_ = lowerBound(index_ + 1, address);
+        }
+
+        if (index_ < relocations.size() && relocations[index_]->address() == address) {
+            return relocations[index_];
+        }
+        return nullptr;
+    }
+
+private:
+    /**
+     * \param first Index to start searching from.
+     * \param address Virtual address.
+     *
+     * \return Index of the first relocation at or after the given index
+     *         with the address not less than the given one.
+     */
+    std::size_t lowerBound(std::size_t first, ByteAddr address) const {
+        return std::lower_bound(relocations_->begin() + first, relocations_->end(), address,
+            [](const Relocation *relocation, ByteAddr a) { return relocation->address() < a; }) - relocations_->begin();
+    }
+};
+
+} // namespace image
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
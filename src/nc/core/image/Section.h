@@ -207,6 +207,8 @@ public:
 
     /**
      * Sets the content of the section.
+     * The array can reference memory that it does not own, e.g. the mapping of
+     * the input file kept by the image; such memory must outlive the section.
      *
      * \param content New content.
      */
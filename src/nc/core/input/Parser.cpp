@@ -40,13 +40,14 @@ bool Parser::canParse(QIODevice *source) const {
     return doCanParse(source);
 }
 
-void Parser::parse(QIODevice *source, image::Image *image, const LogToken &log) const {
+void Parser::parse(QIODevice *source, image::Image *image, const LogToken &log,
+                   const image::MappedFile *mappedFile) const {
     assert(source != nullptr);
     assert(image != nullptr);
 
     try {
         source->seek(0);
-        doParse(source, image, log);
+        doParse(source, image, log, mappedFile);
     } catch (nc::Exception &e) {
         if (!boost::get_error_info<ErrorOffset>(e)) {
             e << ErrorOffset(source->pos());
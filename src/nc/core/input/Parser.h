@@ -42,6 +42,7 @@ class Instructions;
 
 namespace image {
     class Image;
+    class MappedFile;
 }
 
 namespace input {
@@ -98,8 +99,11 @@ public:
      * \param[in] source Valid pointer to the data source.
      * \param[out] image Valid pointer to the image.
      * \param[in] log Log token.
+     * \param[in] mappedFile Mapped contents of the source. Can be nullptr.
+     *                       If given, the image must keep it mapped.
      */
-    void parse(QIODevice *source, image::Image *image, const LogToken &log) const;
+    void parse(QIODevice *source, image::Image *image, const LogToken &log,
+               const image::MappedFile *mappedFile = nullptr) const;
 
 protected:
     /**
@@ -116,8 +120,10 @@ protected:
      * \param[in] source Data source.
      * \param[out] image Valid pointer to the image.
      * \param[in] log Log token.
+     * \param[in] mappedFile Mapped contents of the source. Can be nullptr.
      */
-    virtual void doParse(QIODevice *source, image::Image *image, const LogToken &log) const = 0;
+    virtual void doParse(QIODevice *source, image::Image *image, const LogToken &log,
+                         const image::MappedFile *mappedFile) const = 0;
 };
 
 }}} // namespace nc::core::input
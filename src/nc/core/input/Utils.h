@@ -7,10 +7,13 @@
 
 #include <nc/config.h>
 
+#include <boost/optional.hpp>
+
 #include <QIODevice>
 #include <QString>
 
 #include <nc/common/CheckedCast.h>
+#include <nc/core/image/MappedFile.h>
 
 namespace nc {
 namespace core {
@@ -35,6 +38,38 @@ inline QString getAsciizString(const QByteArray &bytes, std::size_t offset = 0)
         return QString();
     }
 }
+
+/**
+ * Reads a range of bytes of the source, e.g. the contents of a section.
+ * If the source is mapped into memory, the returned array references
+ * the mapped memory and nothing is copied. The position of the source
+ * is preserved.
+ *
+ * \param source Valid pointer to the data source.
+ * \param mappedFile Pointer to the mapped contents of the source. Can be nullptr.
+ *                   If given, the image must keep it mapped.
+ * \param offset Offset of the first byte in the source.
+ * \param size Number of bytes to read.
+ *
+ * \return The bytes read, possibly fewer than requested,
+ *         or boost::none if the source cannot be positioned at the offset.
+ */
+inline boost::optional<QByteArray> readBytes(QIODevice *source, const image::MappedFile *mappedFile, qint64 offset, qint64 size) {
+    if (mappedFile) {
+        if (auto bytes = mappedFile->bytes(offset, size)) {
+            return bytes;
+        }
+    }
+
+    auto pos = source->pos();
+    if (!source->seek(offset)) {
+        return boost::none;
+    }
+    auto result = source->read(size);
+    source->seek(pos);
+    return result;
+}
+
 }}} // namespace nc::core::input
 
 /* vim:set et sts=4 sw=4: */
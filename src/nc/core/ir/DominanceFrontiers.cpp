@@ -0,0 +1,47 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "DominanceFrontiers.h"
+
+#include <nc/common/Foreach.h>
+
+#include "BasicBlock.h"
+#include "CFG.h"
+#include "Dominators.h"
+
+namespace nc {
+namespace core {
+namespace ir {
+
+DominanceFrontiers::DominanceFrontiers(const CFG &cfg, const Dominators &dominators) {
+    foreach (auto basicBlock, cfg.basicBlocks()) {
+        const auto &predecessors = dominators.direction() == Dominators::FORWARD ?
+            cfg.getPredecessors(basicBlock) : cfg.getSuccessors(basicBlock);
+
+        auto immediateDominator = dominators.getImmediateDominator(basicBlock);
+
+        /*
+         * The block is in the frontier of each block on the path in the
+         * dominator tree from its predecessor up to its immediate dominator.
+         */
+        foreach (auto predecessor, predecessors) {
+            if (!dominators.contains(predecessor)) {
+                continue;
+            }
+            for (auto runner = predecessor; runner != immediateDominator && runner != nullptr;
+                 runner = dominators.getImmediateDominator(runner)) {
+                auto &frontier = frontiers_[runner];
+                if (!frontier.empty() && frontier.back() == basicBlock) {
+                    break;
+                }
+                frontier.push_back(basicBlock);
+            }
+        }
+    }
+}
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -0,0 +1,56 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cassert>
+#include <vector>
+
+#include <boost/unordered_map.hpp>
+
+#include <nc/common/Range.h>
+
+namespace nc {
+namespace core {
+namespace ir {
+
+class BasicBlock;
+class CFG;
+class Dominators;
+
+/**
+ * Dominance frontiers of the basic blocks of a control flow graph.
+ * When built from post-dominators, these are the post-dominance
+ * frontiers, i.e. the blocks controlling the execution of a block.
+ */
+class DominanceFrontiers {
+    /** Mapping from a basic block to its dominance frontier. */
+    boost::unordered_map<const BasicBlock *, std::vector<const BasicBlock *>> frontiers_;
+
+public:
+    /**
+     * Computes dominance frontiers.
+     *
+     * \param cfg Control flow graph.
+     * \param dominators Dominator tree of this graph.
+     */
+    DominanceFrontiers(const CFG &cfg, const Dominators &dominators);
+
+    /**
+     * \param basicBlock Valid pointer to a basic block.
+     *
+     * \return The dominance frontier of the basic block.
+     */
+    const std::vector<const BasicBlock *> &getFrontier(const BasicBlock *basicBlock) const {
+        assert(basicBlock != nullptr);
+        return nc::find(frontiers_, basicBlock);
+    }
+};
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
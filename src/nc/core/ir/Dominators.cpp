@@ -3,6 +3,11 @@
 
 #include "Dominators.h"
 
+#include <limits>
+#include <utility>
+
+#include <boost/unordered_set.hpp>
+
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
 
@@ -13,56 +18,171 @@ namespace nc {
 namespace core {
 namespace ir {
 
-Dominators::Dominators(const CFG &cfg, const CancellationToken &canceled) {
+namespace {
+
+const std::size_t NO_INDEX = std::numeric_limits<std::size_t>::max();
+
+} // anonymous namespace
+
+Dominators::Dominators(const CFG &cfg, const CancellationToken &canceled, Direction direction):
+    direction_(direction)
+{
+    auto getSuccessors = [&](const BasicBlock *basicBlock) -> const std::vector<const BasicBlock *> & {
+        return direction == FORWARD ? cfg.getSuccessors(basicBlock) : cfg.getPredecessors(basicBlock);
+    };
+    auto getPredecessors = [&](const BasicBlock *basicBlock) -> const std::vector<const BasicBlock *> & {
+        return direction == FORWARD ? cfg.getPredecessors(basicBlock) : cfg.getSuccessors(basicBlock);
+    };
+
+    foreach (auto basicBlock, cfg.basicBlocks()) {
+        block2index_[basicBlock] = NO_INDEX;
+    }
+
+    auto hasPredecessors = [&](const BasicBlock *basicBlock) -> bool {
+        foreach (auto predecessor, getPredecessors(basicBlock)) {
+            if (contains(predecessor)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
     /*
-     * Each node dominates itself.
+     * Sort the basic blocks in postorder. Successors outside the graph are ignored.
      */
+    std::vector<const BasicBlock *> postorder;
+    postorder.reserve(block2index_.size());
+
+    std::vector<const BasicBlock *> roots;
+    boost::unordered_set<const BasicBlock *> visited;
+    std::vector<std::pair<const BasicBlock *, std::size_t>> stack;
+
+    auto visit = [&](const BasicBlock *root) {
+        if (!visited.insert(root).second) {
+            return;
+        }
+        roots.push_back(root);
+        stack.push_back(std::make_pair(root, 0));
+
+        while (!stack.empty()) {
+            auto basicBlock = stack.back().first;
+            const auto &successors = getSuccessors(basicBlock);
+
+            if (stack.back().second < successors.size()) {
+                auto successor = successors[stack.back().second++];
+                if (contains(successor) && visited.insert(successor).second) {
+                    stack.push_back(std::make_pair(successor, 0));
+                }
+            } else {
+                postorder.push_back(basicBlock);
+                stack.pop_back();
+            }
+        }
+    };
+
+    foreach (auto basicBlock, cfg.basicBlocks()) {
+        if (!hasPredecessors(basicBlock)) {
+            visit(basicBlock);
+        }
+    }
     foreach (auto basicBlock, cfg.basicBlocks()) {
-        dominators_[basicBlock].push_back(basicBlock);
+        visit(basicBlock);
+    }
+
+    /*
+     * Number the basic blocks in reverse postorder.
+     */
+    std::size_t size = postorder.size() + 1;
+
+    blocks_.reserve(size);
+    blocks_.push_back(nullptr);
+    for (auto i = postorder.rbegin(); i != postorder.rend(); ++i) {
+        block2index_[*i] = blocks_.size();
+        blocks_.push_back(*i);
+    }
+
+    std::vector<std::vector<std::size_t>> predecessors(size);
+    foreach (auto root, roots) {
+        predecessors[getIndex(root)].push_back(0);
+    }
+    for (std::size_t i = 1; i < size; ++i) {
+        foreach (auto predecessor, getPredecessors(blocks_[i])) {
+            if (contains(predecessor)) {
+                predecessors[i].push_back(getIndex(predecessor));
+            }
+        }
     }
 
     /*
-     * Recompute dominator sets until fixpoint.
+     * Compute immediate dominators until fixpoint.
      */
+    immediateDominators_.assign(size, NO_INDEX);
+    immediateDominators_[0] = 0;
+
+    auto intersect = [&](std::size_t a, std::size_t b) -> std::size_t {
+        while (a != b) {
+            while (a > b) {
+                a = immediateDominators_[a];
+            }
+            while (b > a) {
+                b = immediateDominators_[b];
+            }
+        }
+        return a;
+    };
+
     bool changed;
     do {
         changed = false;
 
-        foreach (auto basicBlock, cfg.basicBlocks()) {
-            const auto &predecessors = cfg.getPredecessors(basicBlock);
+        for (std::size_t i = 1; i < size; ++i) {
+            std::size_t newDominator = NO_INDEX;
 
-            if (!predecessors.empty()) {
-                boost::unordered_map<const BasicBlock *, std::size_t> intersection;
-                foreach (auto predecessor, predecessors) {
-                    foreach (auto predDominator, dominators_[predecessor]) {
-                        ++intersection[predDominator];
-                    }
+            foreach (auto predecessor, predecessors[i]) {
+                if (immediateDominators_[predecessor] != NO_INDEX) {
+                    newDominator = newDominator == NO_INDEX ? predecessor : intersect(predecessor, newDominator);
                 }
-                intersection.erase(basicBlock);
+            }
 
-                std::vector<const BasicBlock *> newDominators;
-                foreach (const auto &pair, intersection) {
-                    if (pair.second == predecessors.size()) {
-                        newDominators.push_back(pair.first);
-                    }
-                }
-                newDominators.push_back(basicBlock);
-
-                auto &oldDominators = dominators_[basicBlock];
-                /* Sets grow monotonically, so we can just compare sizes. */
-                if (newDominators.size() != oldDominators.size()) {
-                    assert(newDominators.size() > oldDominators.size());
-                    oldDominators = std::move(newDominators);
-                    changed = true;
-                }
+            assert(newDominator != NO_INDEX && "A predecessor preceding the node in reverse postorder must have been processed.");
+
+            if (immediateDominators_[i] != newDominator) {
+                immediateDominators_[i] = newDominator;
+                changed = true;
             }
         }
 
         canceled.poll();
     } while (changed);
 
-    foreach (auto &pair, dominators_) {
-        std::sort(pair.second.begin(), pair.second.end());
+    /*
+     * Number the nodes of the dominator tree in the order of entering and leaving them.
+     */
+    std::vector<std::vector<std::size_t>> children(size);
+    for (std::size_t i = 1; i < size; ++i) {
+        children[immediateDominators_[i]].push_back(i);
+    }
+
+    enterTimes_.resize(size);
+    leaveTimes_.resize(size);
+
+    std::size_t time = 0;
+    std::vector<std::pair<std::size_t, std::size_t>> treeStack;
+
+    enterTimes_[0] = time++;
+    treeStack.push_back(std::make_pair(0, 0));
+
+    while (!treeStack.empty()) {
+        auto node = treeStack.back().first;
+
+        if (treeStack.back().second < children[node].size()) {
+            auto child = children[node][treeStack.back().second++];
+            enterTimes_[child] = time++;
+            treeStack.push_back(std::make_pair(child, 0));
+        } else {
+            leaveTimes_[node] = time++;
+            treeStack.pop_back();
+        }
     }
 }
 
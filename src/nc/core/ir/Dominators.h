@@ -5,6 +5,7 @@
 
 #include <nc/config.h>
 
+#include <cassert>
 #include <vector>
 
 #include <boost/unordered_map.hpp>
@@ -22,31 +23,77 @@ class BasicBlock;
 class CFG;
 
 /**
- * Dominator sets.
+ * Dominator tree of a control flow graph.
+ *
+ * Blocks without predecessors are the children of a virtual root of the tree.
+ * So is the first block of each cycle unreachable from them: from the
+ * point of view of dominance, it is an entry of the graph too.
+ * The nodes of the tree are numbered in the order of entering and leaving
+ * them by a depth-first search, which makes dominance checks O(1).
  */
 class Dominators {
-    /** Mapping from a basic block to the set of its dominators. */
-    boost::unordered_map<const BasicBlock *, std::vector<const BasicBlock *>> dominators_;
+public:
+    /**
+     * Direction of control flow edges to follow.
+     */
+    enum Direction {
+        FORWARD, ///< Compute dominators.
+        BACKWARD ///< Compute post-dominators.
+    };
+
+private:
+    /** Direction of control flow edges being followed. */
+    Direction direction_;
+
+    /** Mapping from a basic block to its index. Indices follow the reverse postorder, 0 is the virtual root. */
+    boost::unordered_map<const BasicBlock *, std::size_t> block2index_;
+
+    /** Basic blocks by their indices. The virtual root is nullptr. */
+    std::vector<const BasicBlock *> blocks_;
+
+    /** Index of the immediate dominator of each node. */
+    std::vector<std::size_t> immediateDominators_;
+
+    /** Time of entering each node by a depth-first search in the dominator tree. */
+    std::vector<std::size_t> enterTimes_;
+
+    /** Time of leaving each node by a depth-first search in the dominator tree. */
+    std::vector<std::size_t> leaveTimes_;
 
 public:
     /**
-     * Constructs dominator sets from the control flow graph.
-     * Uses classic iterative algorithm for that.
+     * Constructs the dominator tree of the control flow graph.
+     * Uses the algorithm of Cooper, Harvey, and Kennedy for that.
      *
      * \param cfg Control flow graph.
      * \param canceled Cancellation token.
+     * \param direction Whether to compute dominators or post-dominators.
+     */
+    Dominators(const CFG &cfg, const CancellationToken &canceled, Direction direction = FORWARD);
+
+    /**
+     * \return Direction of control flow edges followed: FORWARD for dominators, BACKWARD for post-dominators.
      */
-    Dominators(const CFG &cfg, const CancellationToken &canceled);
+    Direction direction() const { return direction_; }
 
     /**
      * \param basicBlock Valid pointer to a basic block.
      *
-     * \return The set of dominators of this basic block.
+     * \return True iff the basic block belongs to the control flow graph the tree was built from.
      */
-    const std::vector<const BasicBlock *> &getDominators(const BasicBlock *basicBlock) const {
+    bool contains(const BasicBlock *basicBlock) const {
         assert(basicBlock != nullptr);
-        assert(nc::contains(dominators_, basicBlock));
-        return nc::find(dominators_, basicBlock);
+        return nc::contains(block2index_, basicBlock);
+    }
+
+    /**
+     * \param basicBlock Valid pointer to a basic block of the control flow graph.
+     *
+     * \return Pointer to the immediate dominator of the basic block.
+     *         nullptr if the basic block is an entry of the graph.
+     */
+    const BasicBlock *getImmediateDominator(const BasicBlock *basicBlock) const {
+        return blocks_[immediateDominators_[getIndex(basicBlock)]];
     }
 
     /**
@@ -56,13 +103,21 @@ public:
      * \return True of dominating dominates dominated.
      */
     bool isDominating(const BasicBlock *dominating, const BasicBlock *dominated) const {
-        assert(dominating != nullptr);
-        assert(nc::contains(dominators_, dominating));
-        assert(dominated != nullptr);
-        assert(nc::contains(dominators_, dominated));
+        auto i = getIndex(dominating);
+        auto j = getIndex(dominated);
 
-        const auto &dominators = getDominators(dominated);
-        return std::binary_search(dominators.begin(), dominators.end(), dominating);
+        return enterTimes_[i] <= enterTimes_[j] && leaveTimes_[j] <= leaveTimes_[i];
+    }
+
+private:
+    /**
+     * \param basicBlock Valid pointer to a basic block of the control flow graph.
+     *
+     * \return Index of the basic block.
+     */
+    std::size_t getIndex(const BasicBlock *basicBlock) const {
+        assert(contains(basicBlock));
+        return nc::find(block2index_, basicBlock);
     }
 };
 
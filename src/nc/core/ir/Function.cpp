@@ -37,12 +37,15 @@ namespace nc {
 namespace core {
 namespace ir {
 
-Function::Function(): entry_(nullptr) {}
+Function::Function(): entry_(nullptr), degraded_(false) {}
 
 Function::~Function() {}
 
 void Function::addBasicBlock(std::unique_ptr<BasicBlock> basicBlock) {
     basicBlock->setFunction(this);
+    foreach (auto statement, basicBlock->statements()) {
+        numbering_.assignIds(statement);
+    }
     basicBlocks_.push_back(std::move(basicBlock));
 }
 
@@ -33,6 +33,8 @@
 #include <nc/common/Printable.h>
 #include <nc/common/ilist.h>
 
+#include "Numbering.h"
+
 namespace nc {
 namespace core {
 namespace ir {
@@ -49,6 +51,8 @@ public:
 private:
     BasicBlock *entry_; ///< Entry basic block.
     BasicBlocks basicBlocks_; ///< All basic blocks of the function.
+    Numbering numbering_; ///< Source of ids of the function's statements and terms.
+    bool degraded_; ///< Whether the function exceeded its analysis budget.
 
 public:
     /**
@@ -101,6 +105,29 @@ public:
      */
     void addBasicBlock(std::unique_ptr<BasicBlock> basicBlock);
 
+    /**
+     * \return Source of ids of the function's statements and terms.
+     *         Statements get their ids when they are added to the function.
+     */
+    Numbering &numbering() { return numbering_; }
+
+    /**
+     * \return Source of ids of the function's statements and terms.
+     */
+    const Numbering &numbering() const { return numbering_; }
+
+    /**
+     * \return True iff the function exceeded its analysis budget and was analyzed
+     *         in a cheaper way: its control flow can be left unstructured, and
+     *         neither its signature nor its types are reconstructed.
+     */
+    bool isDegraded() const { return degraded_; }
+
+    /**
+     * Marks the function as exceeding its analysis budget.
+     */
+    void setDegraded() { degraded_ = true; }
+
     /**
      * \return True iff this function has no statements in its basic blocks.
      */
@@ -25,7 +25,7 @@
 #include "FunctionsGenerator.h"
 
 #include <boost/range/adaptor/map.hpp>
-#include <boost/unordered_set.hpp>
+#include <boost/unordered_map.hpp>
 
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
@@ -46,28 +46,93 @@ namespace ir {
 
 namespace {
 
-void dfs(
-    const CFG &cfg,
-    const BasicBlock *basicBlock,
-    boost::unordered_set<const BasicBlock *> &visited,
-    std::vector<const BasicBlock *> &trace)
-{
-    visited.insert(basicBlock);
-    trace.push_back(basicBlock);
-
-    foreach (const BasicBlock *successor, cfg.getSuccessors(basicBlock)) {
-        if (visited.find(successor) == visited.end()) {
-            dfs(cfg, successor, visited, trace);
+/**
+ * Depth-first search over the basic blocks of a program.
+ *
+ * Uses an explicit stack, so that huge functions do not overflow the thread's stack.
+ * Basic blocks are numbered densely; a basic block counts as visited if its mark
+ * equals the mark of the current search.
+ */
+class Dfs {
+    const CFG &cfg_;
+    boost::unordered_map<const BasicBlock *, std::size_t> block2index_;
+
+    /** A basic block on the stack and the number of its successors already followed. */
+    std::vector<std::pair<const BasicBlock *, std::size_t>> stack_;
+
+public:
+    Dfs(const CFG &cfg): cfg_(cfg) {
+        foreach (const BasicBlock *basicBlock, cfg.basicBlocks()) {
+            block2index_.emplace(basicBlock, block2index_.size());
         }
     }
-}
+
+    /**
+     * \return Number of basic blocks.
+     */
+    std::size_t size() const { return block2index_.size(); }
+
+    /**
+     * \param basicBlock Valid pointer to a basic block of the program.
+     *
+     * \return Index of the basic block.
+     */
+    std::size_t getIndex(const BasicBlock *basicBlock) const {
+        assert(nc::contains(block2index_, basicBlock));
+        return nc::find(block2index_, basicBlock);
+    }
+
+    /**
+     * Visits the given basic block and all the basic blocks reachable from it
+     * via not yet visited basic blocks, in depth-first order.
+     *
+     * \param[in] basicBlock Valid pointer to a not yet visited basic block.
+     * \param[in,out] marks Marks of the basic blocks.
+     * \param[in] mark Mark of the current search.
+     * \param[out] trace Basic blocks in the order of visiting.
+     */
+    void visit(const BasicBlock *basicBlock, std::vector<std::size_t> &marks, std::size_t mark,
+               std::vector<const BasicBlock *> &trace)
+    {
+        assert(marks[getIndex(basicBlock)] != mark);
+
+        marks[getIndex(basicBlock)] = mark;
+        trace.push_back(basicBlock);
+        stack_.push_back(std::make_pair(basicBlock, 0));
+
+        while (!stack_.empty()) {
+            auto &top = stack_.back();
+            const auto &successors = cfg_.getSuccessors(top.first);
+
+            if (top.second < successors.size()) {
+                const BasicBlock *successor = successors[top.second++];
+                auto &successorMark = marks[getIndex(successor)];
+
+                if (successorMark != mark) {
+                    successorMark = mark;
+                    trace.push_back(successor);
+                    stack_.push_back(std::make_pair(successor, 0));
+                }
+            } else {
+                stack_.pop_back();
+            }
+        }
+    }
+};
 
 } // anonymous namespace
 
 void FunctionsGenerator::makeFunctions(const Program &program, Functions &functions) const {
-    boost::unordered_set<const BasicBlock *> processed;
-
     CFG cfg(program.basicBlocks());
+    Dfs dfs(cfg);
+
+    /* Basic blocks already put into some function are marked with 1. */
+    const std::size_t processedMark = 1;
+    std::vector<std::size_t> processed(dfs.size());
+
+    auto isProcessed = [&](const BasicBlock *basicBlock) {
+        return processed[dfs.getIndex(basicBlock)] == processedMark;
+    };
 
     auto addFunction = [&](const std::vector<const BasicBlock *> &basicBlocks, const BasicBlock *entry) {
         auto function = makeFunction(basicBlocks, entry);
@@ -94,34 +159,39 @@ void FunctionsGenerator::makeFunctions(const Program &program, Functions &functi
         functions.addFunction(std::move(function));
     };
 
-    /* Generate all functions being called. */
+    /* Generate all functions being called. Each of them gets a search of its own. */
+    std::vector<std::size_t> visited(dfs.size());
+    std::size_t search = 0;
+
     foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
         if (basicBlock->address() && program.isCalledAddress(*basicBlock->address())) {
-            boost::unordered_set<const BasicBlock *> visited;
             std::vector<const BasicBlock *> trace;
 
-            dfs(cfg, basicBlock, visited, trace);
+            dfs.visit(basicBlock, visited, ++search, trace);
             addFunction(trace, basicBlock);
-            processed.insert(trace.begin(), trace.end());
+
+            foreach (const BasicBlock *traced, trace) {
+                processed[dfs.getIndex(traced)] = processedMark;
+            }
         }
     }
 
     /* Single out all other possible functions. */
     foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
-        if (basicBlock->address() && cfg.getPredecessors(basicBlock).empty() && !contains(processed, basicBlock)) {
+        if (basicBlock->address() && cfg.getPredecessors(basicBlock).empty() && !isProcessed(basicBlock)) {
             std::vector<const BasicBlock *> trace;
 
-            dfs(cfg, basicBlock, processed, trace);
+            dfs.visit(basicBlock, processed, processedMark, trace);
             addFunction(trace, basicBlock);
         }
     }
 
     /* Single out remaining weird strongly connected components. */
     foreach (const BasicBlock *basicBlock, program.basicBlocks()) {
-        if (basicBlock->address() && !contains(processed, basicBlock)) {
+        if (basicBlock->address() && !isProcessed(basicBlock)) {
             std::vector<const BasicBlock *> trace;
 
-            dfs(cfg, basicBlock, processed, trace);
+            dfs.visit(basicBlock, processed, processedMark, trace);
             addFunction(trace, basicBlock);
         }
     }
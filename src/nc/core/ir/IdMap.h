@@ -0,0 +1,183 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cassert>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include <boost/iterator/filter_iterator.hpp>
+
+namespace nc {
+namespace core {
+namespace ir {
+
+/**
+ * Associative container mapping numbered objects (statements or terms)
+ * to values. Values are stored in a contiguous storage indexed by the ids
+ * of the keys, so that lookups do not involve hashing.
+ *
+ * References to the stored values stay valid until the value is erased,
+ * even when other keys are inserted.
+ *
+ * \tparam Key Type of the key objects. Must have id() method and NO_ID constant.
+ * \tparam T Type of the values. Must be default-constructible.
+ */
+template<class Key, class T>
+class IdMap {
+public:
+    typedef std::pair<const Key *, T> value_type;
+
+private:
+    typedef std::deque<value_type> Entries;
+
+    /** Entries indexed by the ids of their keys. Entries with nullptr key are vacant. */
+    Entries entries_;
+
+    /** Number of occupied entries. */
+    std::size_t size_;
+
+    struct IsOccupied {
+        bool operator()(const value_type &entry) const { return entry.first != nullptr; }
+    };
+
+public:
+    typedef boost::filter_iterator<IsOccupied, typename Entries::iterator> iterator;
+    typedef boost::filter_iterator<IsOccupied, typename Entries::const_iterator> const_iterator;
+
+    /**
+     * Constructs an empty map.
+     */
+    IdMap(): size_(0) {}
+
+    /**
+     * \param key Valid pointer to a numbered key.
+     *
+     * \return Reference to the value associated with the key.
+     *         If there was none, a default-constructed value is inserted,
+     *         replacing the value of another key with the same id, if any.
+     */
+    T &operator[](const Key *key) {
+        assert(key != nullptr);
+        assert(key->id() != Key::NO_ID && "The key must be numbered.");
+
+        if (key->id() >= entries_.size()) {
+            entries_.resize(key->id() + 1);
+        }
+
+        auto &entry = entries_[key->id()];
+        if (entry.first != key) {
+            if (entry.first == nullptr) {
+                ++size_;
+            }
+            entry.first = key;
+            entry.second = T();
+        }
+        return entry.second;
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Pointer to the value associated with the key, or nullptr if there is none.
+     */
+    T *find(const Key *key) {
+        assert(key != nullptr);
+
+        if (key->id() < entries_.size()) {
+            auto &entry = entries_[key->id()];
+            if (entry.first == key) {
+                return &entry.second;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * \param key Valid pointer to a key.
+     *
+     * \return Pointer to the value associated with the key, or nullptr if there is none.
+     */
+    const T *find(const Key *key) const {
+        return const_cast<IdMap *>(this)->find(key);
+    }
+
+    /**
+     * Removes the value pointed to by the given iterator.
+     *
+     * \param i Valid dereferenceable iterator.
+     *
+     * \return Iterator pointing to the next value.
+     */
+    iterator erase(iterator i) {
+        auto next = i;
+        ++next;
+
+        auto &entry = *i.base();
+        entry.first = nullptr;
+        entry.second = T();
+        --size_;
+
+        return next;
+    }
+
+    /**
+     * Removes the values of all the keys except the given ones.
+     * The keys of the removed values are not dereferenced,
+     * so they may be already destroyed.
+     *
+     * \param keys Range of valid pointers to the keys whose values must be kept.
+     */
+    template<class Range>
+    void retain(const Range &keys) {
+        std::vector<const Key *> kept(entries_.size());
+        for (const Key *key : keys) {
+            if (key->id() < kept.size()) {
+                kept[key->id()] = key;
+            }
+        }
+
+        for (std::size_t id = 0; id < entries_.size(); ++id) {
+            auto &entry = entries_[id];
+            if (entry.first != nullptr && entry.first != kept[id]) {
+                entry.first = nullptr;
+                entry.second = T();
+                --size_;
+            }
+        }
+    }
+
+    /**
+     * Removes all the values.
+     */
+    void clear() {
+        entries_.clear();
+        size_ = 0;
+    }
+
+    /**
+     * \return Number of values in the map.
+     */
+    std::size_t size() const { return size_; }
+
+    /**
+     * \return True if the map is empty, false otherwise.
+     */
+    bool empty() const { return size_ == 0; }
+
+    iterator begin() { return iterator(entries_.begin(), entries_.end()); }
+    iterator end() { return iterator(entries_.end(), entries_.end()); }
+    const_iterator begin() const { return const_iterator(entries_.begin(), entries_.end()); }
+    const_iterator end() const { return const_iterator(entries_.end(), entries_.end()); }
+};
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -71,6 +71,11 @@ public:
      */
     const Term *condition() const { return condition_.get(); }
 
+    /**
+     * \return Pointer to the term representing jump condition, nullptr for unconditional jump.
+     */
+    Term *condition() { return condition_.get(); }
+
     /**
      * \return True if this is a conditional jump, false if this is an unconditional jump.
      */
@@ -0,0 +1,107 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "Numbering.h"
+
+#include "Jump.h"
+#include "Statements.h"
+#include "Term.h"
+
+namespace nc {
+namespace core {
+namespace ir {
+
+namespace {
+
+/**
+ * Calls the given function on the term and all its children.
+ *
+ * \param term Pointer to a term. Can be nullptr.
+ * \param fun Function to call.
+ */
+template<class F>
+void visitTerms(Term *term, const F &fun) {
+    if (term == nullptr) {
+        return;
+    }
+
+    fun(term);
+    term->callOnChildren([&fun](Term *child) { visitTerms(child, fun); });
+}
+
+/**
+ * Calls the given function on all the terms of the statement.
+ *
+ * \param statement Valid pointer to a statement.
+ * \param fun Function to call.
+ */
+template<class F>
+void visitTerms(Statement *statement, const F &fun) {
+    assert(statement != nullptr);
+
+    switch (statement->kind()) {
+        case Statement::INLINE_ASSEMBLY:
+            break;
+        case Statement::ASSIGNMENT: {
+            auto assignment = statement->as<Assignment>();
+            visitTerms(assignment->left(), fun);
+            visitTerms(assignment->right(), fun);
+            break;
+        }
+        case Statement::JUMP: {
+            auto jump = statement->as<Jump>();
+            visitTerms(jump->condition(), fun);
+            visitTerms(jump->thenTarget().address(), fun);
+            visitTerms(jump->elseTarget().address(), fun);
+            break;
+        }
+        case Statement::CALL:
+            visitTerms(statement->as<Call>()->target(), fun);
+            break;
+        case Statement::HALT:
+            break;
+        case Statement::TOUCH:
+            visitTerms(statement->as<Touch>()->term(), fun);
+            break;
+        case Statement::CALLBACK:
+            break;
+        case Statement::REMEMBER_REACHING_DEFINITIONS:
+            break;
+        default:
+            /* User-defined statements have no terms known to us. */
+            break;
+    }
+}
+
+} // anonymous namespace
+
+void Numbering::assignIds(Statement *statement) {
+    assert(statement != nullptr);
+
+    if (statement->id() == Statement::NO_ID) {
+        statement->setId(statementCount_++);
+    } else {
+        assert(statement->id() < statementCount_ && "The statement must be numbered by this object.");
+    }
+
+    visitTerms(statement, [this](Term *term) {
+        if (term->id() == Term::NO_ID) {
+            term->setId(termCount_++);
+        } else {
+            assert(term->id() < termCount_ && "The term must be numbered by this object.");
+        }
+    });
+}
+
+void Numbering::clearIds(Statement *statement) {
+    assert(statement != nullptr);
+
+    statement->setId(Statement::NO_ID);
+    visitTerms(statement, [](Term *term) { term->setId(Term::NO_ID); });
+}
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
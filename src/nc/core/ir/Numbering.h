@@ -0,0 +1,73 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <cstddef>
+
+namespace nc {
+namespace core {
+namespace ir {
+
+class Statement;
+class Term;
+
+/**
+ * Assigns dense ids to statements and terms.
+ *
+ * Statements and terms numbered by the same object get ids
+ * 0, 1, 2, ... in the order in which they are numbered. This
+ * lets analyses keep their results in vectors indexed by ids.
+ *
+ * Statements and terms that already have ids keep them. Therefore,
+ * a statement removed from a function and inserted back (e.g. a hook
+ * patch) is still associated with the analysis results computed for it.
+ */
+class Numbering {
+    std::size_t statementCount_; ///< Number of statements numbered so far.
+    std::size_t termCount_; ///< Number of terms numbered so far.
+
+public:
+    /**
+     * Constructor.
+     */
+    Numbering(): statementCount_(0), termCount_(0) {}
+
+    /**
+     * Assigns fresh ids to the given statement and all its terms
+     * that do not have ids yet.
+     *
+     * \param statement Valid pointer to a statement. If it or any of its
+     *                  terms have ids, they must be assigned by this object.
+     */
+    void assignIds(Statement *statement);
+
+    /**
+     * Resets the ids of the given statement and all its terms to NO_ID,
+     * so that they can be numbered by another object.
+     *
+     * \param statement Valid pointer to a statement.
+     */
+    static void clearIds(Statement *statement);
+
+    /**
+     * \return Number of statements numbered so far. All ids of statements
+     *         numbered by this object are less than this number.
+     */
+    std::size_t statementCount() const { return statementCount_; }
+
+    /**
+     * \return Number of terms numbered so far. All ids of terms
+     *         numbered by this object are less than this number.
+     */
+    std::size_t termCount() const { return termCount_; }
+
+};
+
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
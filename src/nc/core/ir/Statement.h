@@ -26,6 +26,7 @@
 #include <nc/config.h>
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 
 #include <boost/noncopyable.hpp>
@@ -80,6 +81,7 @@ public:
 private:
     BasicBlock *basicBlock_; ///< Basic block to which this statement belongs.
     const arch::Instruction *instruction_; ///< Instruction from which this statement was generated.
+    std::size_t id_; ///< Id of the statement.
 
 public:
     /**
@@ -87,7 +89,7 @@ public:
      *
      * \param[in] kind Kind of the statement.
      */
-    explicit Statement(int kind): kind_(kind), basicBlock_(nullptr), instruction_(nullptr) {}
+    explicit Statement(int kind): kind_(kind), basicBlock_(nullptr), instruction_(nullptr), id_(NO_ID) {}
 
     /**
      * \return Pointer to the basic block to which this statement belongs.
@@ -108,6 +110,24 @@ public:
      */
     void setBasicBlock(BasicBlock *basicBlock) { basicBlock_ = basicBlock; }
 
+    /**
+     * Value of id() of a statement that was not numbered.
+     */
+    static const std::size_t NO_ID = static_cast<std::size_t>(-1);
+
+    /**
+     * \return Id of the statement, dense among the statements of the function
+     *         the statement belongs to, or NO_ID if the statement was not numbered.
+     */
+    std::size_t id() const { return id_; }
+
+    /**
+     * Sets the id of the statement.
+     *
+     * \param id New id.
+     */
+    void setId(std::size_t id) { id_ = id; }
+
     /**
      * \param[in] instruction Instruction from which this statement was generated.
      */
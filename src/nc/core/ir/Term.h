@@ -26,6 +26,7 @@
 #include <nc/config.h>
 
 #include <cassert>
+#include <cstddef>
 #include <memory>
 
 #include <boost/noncopyable.hpp>
@@ -79,6 +80,7 @@ public:
 private:
     const Statement *statement_; ///< Statement that this term belongs to.
     SmallBitSize size_; ///< Size of this term's value in bits.
+    std::size_t id_; ///< Id of the term.
 
 public:
     /**
@@ -88,7 +90,7 @@ public:
      * \param[in] size Size of this term's value in bits.
      */
     Term(int kind, SmallBitSize size):
-        kind_(kind), statement_(nullptr), size_(size)
+        kind_(kind), statement_(nullptr), size_(size), id_(NO_ID)
     {
         assert(size != 0);
     }
@@ -98,6 +100,24 @@ public:
      */
     SmallBitSize size() const { return size_; }
 
+    /**
+     * Value of id() of a term that was not numbered.
+     */
+    static const std::size_t NO_ID = static_cast<std::size_t>(-1);
+
+    /**
+     * \return Id of the term, dense among the terms of the function
+     *         the term belongs to, or NO_ID if the term was not numbered.
+     */
+    std::size_t id() const { return id_; }
+
+    /**
+     * Sets the id of the term.
+     *
+     * \param id New id.
+     */
+    void setId(std::size_t id) { id_ = id; }
+
     /**
      * \return Pointer to the statement this term belongs to. Can be nullptr.
      */
@@ -51,6 +51,48 @@ namespace core {
 namespace ir {
 namespace calling {
 
+namespace {
+
+/**
+ * Moves the hooks created for an object, satisfying the given predicate,
+ * from one map of hooks to another. The first element of the keys of the maps
+ * identifies the object for which the hook was created.
+ *
+ * \param from Map to move the hooks from.
+ * \param to Map to move the hooks to.
+ * \param first The smallest key with the object as its first element.
+ * \param predicate Predicate taking a key-value pair of the map.
+ */
+template<class Map, class Predicate>
+void moveHooks(Map &from, Map &to, const typename Map::key_type &first, Predicate predicate) {
+    for (auto i = from.lower_bound(first); i != from.end() && std::get<0>(i->first) == std::get<0>(first);) {
+        if (predicate(*i)) {
+            to.insert(std::move(*i));
+            i = from.erase(i);
+        } else {
+            ++i;
+        }
+    }
+}
+
+/**
+ * Moves the value associated with the given key, if any, from one map to another.
+ *
+ * \param from Map to move the value from.
+ * \param to Map to move the value to.
+ * \param key Key.
+ */
+template<class Map, class Key>
+void moveValue(Map &from, Map &to, const Key &key) {
+    auto i = from.find(key);
+    if (i != from.end()) {
+        to[key] = i->second;
+        from.erase(i);
+    }
+}
+
+} // anonymous namespace
+
 Hooks::Hooks(const Conventions &conventions, const Signatures &signatures):
     conventions_(conventions), signatures_(signatures)
 {}
@@ -61,6 +103,9 @@ const Convention *Hooks::getConvention(const CalleeId &calleeId) const {
     if (!calleeId) {
         return nullptr;
     }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (auto result = conventions_.getConvention(calleeId)) {
         return result;
     } else {
@@ -72,18 +117,21 @@ const Convention *Hooks::getConvention(const CalleeId &calleeId) const {
 const EntryHook *Hooks::getEntryHook(const Function *function) const {
     assert(function != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     return nc::find(lastEntryHooks_, function);
 }
 
 const CallHook *Hooks::getCallHook(const Call *call) const {
     assert(call != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     return nc::find(lastCallHooks_, call);
 }
 
 const ReturnHook *Hooks::getReturnHook(const Jump *jump) const {
     assert(jump != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     return nc::find(lastReturnHooks_, jump);
 }
 
@@ -91,10 +139,13 @@ void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
     assert(function != nullptr);
     assert(dataflow != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     deinstrument(function);
 
     if (function->entry()) {
         function2callback_[function] = function->entry()->pushFront(std::make_unique<Callback>([=](){
+            std::lock_guard<std::recursive_mutex> lock(mutex_);
             instrumentEntry(function);
         }));
     }
@@ -103,10 +154,12 @@ void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
         foreach (auto statement, basicBlock->statements()) {
             if (auto call = statement->as<Call>()) {
                 call2callback_[call] = basicBlock->insertAfter(call, std::make_unique<Callback>([=](){
+                    std::lock_guard<std::recursive_mutex> lock(mutex_);
                     instrumentCall(call, *dataflow);
                 }));
             } else if (auto jump = statement->as<Jump>()) {
                 jump2callback_[jump] = basicBlock->insertBefore(jump, std::make_unique<Callback>([=](){
+                    std::lock_guard<std::recursive_mutex> lock(mutex_);
                     if (dflow::isReturn(jump, *dataflow)) {
                         instrumentReturn(jump);
                     } else {
@@ -121,6 +174,8 @@ void Hooks::instrument(Function *function, const dflow::Dataflow *dataflow) {
 void Hooks::deinstrument(Function *function) {
     assert(function != nullptr);
 
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
     if (auto callback = nc::find(function2callback_, function)) {
         deinstrumentEntry(function);
         callback->basicBlock()->erase(callback);
@@ -146,6 +201,99 @@ void Hooks::deinstrument(Function *function) {
     }
 }
 
+void Hooks::restore(Function *function, const dflow::Dataflow *dataflow) {
+    assert(function != nullptr);
+    assert(dataflow != nullptr);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+
+    instrument(function, dataflow);
+
+    std::vector<const Callback *> callbacks;
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto callback = statement->asCallback()) {
+                callbacks.push_back(callback);
+            }
+        }
+    }
+
+    foreach (auto callback, callbacks) {
+        callback->function()();
+    }
+}
+
+void Hooks::transfer(Function *function, Hooks &hooks) {
+    assert(function != nullptr);
+    assert(&hooks != this);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> hooksLock(hooks.mutex_);
+
+    moveValue(function2callback_, hooks.function2callback_, function);
+    moveValue(lastEntryHooks_, hooks.lastEntryHooks_, function);
+    moveHooks(entryHooks_, hooks.entryHooks_, decltype(entryHooks_)::key_type(function, nullptr, nullptr),
+              [](const decltype(entryHooks_)::value_type &) { return true; });
+
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto call = statement->as<Call>()) {
+                moveValue(call2callback_, hooks.call2callback_, call);
+                moveValue(lastCallHooks_, hooks.lastCallHooks_, call);
+                moveHooks(callHooks_, hooks.callHooks_,
+                          decltype(callHooks_)::key_type(call, nullptr, nullptr, boost::none),
+                          [](const decltype(callHooks_)::value_type &) { return true; });
+            } else if (auto jump = statement->as<Jump>()) {
+                moveValue(jump2callback_, hooks.jump2callback_, jump);
+                moveValue(lastReturnHooks_, hooks.lastReturnHooks_, jump);
+                moveHooks(returnHooks_, hooks.returnHooks_, decltype(returnHooks_)::key_type(jump, nullptr, nullptr),
+                          [](const decltype(returnHooks_)::value_type &) { return true; });
+            }
+        }
+    }
+}
+
+void Hooks::transferStale(Function *function, Hooks &hooks) {
+    assert(function != nullptr);
+    assert(&hooks != this);
+
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    std::lock_guard<std::recursive_mutex> hooksLock(hooks.mutex_);
+
+    /* A hook is stale if it is not in use and was created for another, non-null signature. */
+    auto stale = [](const void *hook, const void *lastHook, const void *signature, const void *currentSignature) {
+        return hook != lastHook && signature != nullptr && signature != currentSignature;
+    };
+
+    auto functionSignature = signatures_.getSignature(function).get();
+
+    auto lastEntryHook = nc::find(lastEntryHooks_, function);
+    moveHooks(entryHooks_, hooks.entryHooks_, decltype(entryHooks_)::key_type(function, nullptr, nullptr),
+              [&](const decltype(entryHooks_)::value_type &pair) {
+                  return stale(pair.second.get(), lastEntryHook, std::get<2>(pair.first), functionSignature);
+              });
+
+    foreach (auto basicBlock, function->basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto call = statement->as<Call>()) {
+                auto lastCallHook = nc::find(lastCallHooks_, call);
+                auto callSignature = signatures_.getSignature(call).get();
+                moveHooks(callHooks_, hooks.callHooks_,
+                          decltype(callHooks_)::key_type(call, nullptr, nullptr, boost::none),
+                          [&](const decltype(callHooks_)::value_type &pair) {
+                              return stale(pair.second.get(), lastCallHook, std::get<2>(pair.first), callSignature);
+                          });
+            } else if (auto jump = statement->as<Jump>()) {
+                auto lastReturnHook = nc::find(lastReturnHooks_, jump);
+                moveHooks(returnHooks_, hooks.returnHooks_, decltype(returnHooks_)::key_type(jump, nullptr, nullptr),
+                          [&](const decltype(returnHooks_)::value_type &pair) {
+                              return stale(pair.second.get(), lastReturnHook, std::get<2>(pair.first), functionSignature);
+                          });
+            }
+        }
+    }
+}
+
 void Hooks::instrumentEntry(Function *function) {
     auto convention = getConvention(getCalleeId(function));
     auto signature = signatures_.getSignature(function).get();
@@ -32,6 +32,7 @@
  */
 #include <functional>
 #include <map> 
+#include <mutex>
 #include <tuple>
 #include <vector>
 
@@ -71,6 +72,8 @@ class Signatures;
  * Hooks manager: it is responsible for instrumenting functions
  * with special hooks that take care of handling calling-convention-specific
  * stuff.
+ *
+ * Different functions can be instrumented and analyzed concurrently.
  */
 class Hooks {
     /** Assigned calling conventions. */
@@ -114,6 +117,9 @@ private:
     /** Mapping from a return jump to the last return hook used for instrumenting it. */
     boost::unordered_map<const Jump *, ReturnHook *> lastReturnHooks_;
 
+    /** Mutex protecting all the above, as well as the assigned calling conventions. */
+    mutable std::recursive_mutex mutex_;
+
 public:
     /**
      * Constructor.
@@ -195,6 +201,39 @@ public:
      */
     void deinstrument(Function *function);
 
+    /**
+     * Instruments the function and executes the inserted callback statements,
+     * without running the dataflow analyzer. Given the dataflow computed for
+     * the function earlier, this brings back the hooks which were in place
+     * when the dataflow was computed, so that the dataflow can be reused.
+     *
+     * \param function Valid pointer to a function.
+     * \param dataflow Valid pointer to the dataflow information computed for the function.
+     */
+    void restore(Function *function, const dflow::Dataflow *dataflow);
+
+    /**
+     * Moves the callbacks and hooks created for a function into another
+     * hooks manager, which becomes their owner. Afterwards, this hooks
+     * manager knows nothing about the function.
+     *
+     * \param function Valid pointer to a function.
+     * \param hooks Hooks manager to move the callbacks and hooks into.
+     */
+    void transfer(Function *function, Hooks &hooks);
+
+    /**
+     * Moves the hooks of a function that are not used for instrumenting it and
+     * that were created for signatures other than the current ones into another
+     * hooks manager, which becomes their owner. Hooks created without
+     * a signature are kept, as they are needed for restoring the function
+     * in the next incremental decompilation.
+     *
+     * \param function Valid pointer to a function.
+     * \param hooks Hooks manager to move the hooks into.
+     */
+    void transferStale(Function *function, Hooks &hooks);
+
 private:
     /**
      * Creates an EntryHook (if not done yet) and instruments the function with it.
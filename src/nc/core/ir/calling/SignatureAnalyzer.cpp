@@ -18,6 +18,7 @@
 #include <nc/core/ir/Terms.h>
 #include <nc/core/ir/dflow/Dataflows.h>
 #include <nc/core/ir/dflow/Uses.h>
+#include <nc/core/ir/dflow/UsesMap.h>
 #include <nc/core/ir/dflow/Value.h>
 #include <nc/core/ir/dflow/Utils.h>
 #include <nc/core/ir/liveness/Livenesses.h>
@@ -35,18 +36,18 @@ namespace core {
 namespace ir {
 namespace calling {
 
-SignatureAnalyzer::SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows, const Hooks &hooks,
+SignatureAnalyzer::SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows,
+                                     const dflow::UsesMap &uses, const Hooks &hooks,
                                      const liveness::Livenesses &livenesses, const CancellationToken &canceled,
                                      const LogToken &log)
-    : signatures_(signatures), dataflows_(dataflows), hooks_(hooks), livenesses_(livenesses), canceled_(canceled),
-      log_(log) {
+    : signatures_(signatures), dataflows_(dataflows), uses_(uses), hooks_(hooks), livenesses_(livenesses),
+      canceled_(canceled), log_(log) {
 }
 
 SignatureAnalyzer::~SignatureAnalyzer() {}
 
 void SignatureAnalyzer::analyze() {
     computeMappings();
-    computeUses();
     computeArgumentsAndReturnValues();
     computeSignatures();
 }
@@ -58,6 +59,11 @@ void SignatureAnalyzer::computeMappings() {
 
         id2referrers_[getCalleeId(function)].functions.push_back(function);
 
+        /* Bodies of functions exceeding their budget are not used for reconstructing signatures. */
+        if (function->isDegraded()) {
+            continue;
+        }
+
         foreach (auto basicBlock, function->basicBlocks()) {
             foreach (auto statement, basicBlock->statements()) {
                 if (auto call = statement->asCall()) {
@@ -86,12 +92,6 @@ void SignatureAnalyzer::computeMappings() {
     }
 }
 
-void SignatureAnalyzer::computeUses() {
-    foreach (const auto &functionAndDataflow, dataflows_) {
-        function2uses_[functionAndDataflow.first] = std::make_unique<dflow::Uses>(*functionAndDataflow.second);
-    }
-}
-
 void SignatureAnalyzer::computeArgumentsAndReturnValues() {
     int niterations = 0;
 
@@ -334,10 +334,14 @@ public:
 std::vector<MemoryLocation> SignatureAnalyzer::getUndefinedUses(const Function *function) {
     assert(function != nullptr);
 
-    auto &dataflow = *dataflows_.at(function);
-
     std::vector<MemoryLocation> result;
 
+    if (function->isDegraded()) {
+        return result;
+    }
+
+    auto &dataflow = *dataflows_.at(function);
+
     /*
      * If a term reads a memory location through which an argument
      * can be passed, and nobody defines this memory location, this
@@ -388,7 +392,7 @@ std::vector<MemoryLocation> SignatureAnalyzer::getUnusedDefines(const Call *call
     auto callHook = hooks_.getCallHook(call);
     auto function = call->basicBlock()->function();
     auto &dataflow = *dataflows_.at(function);
-    auto &uses = *function2uses_.at(function);
+    auto &uses = *uses_.at(function);
     auto fixer = StackOffsetFixer(callHook->stackPointer(), dataflow);
 
     foreach (const auto &chunk, dataflow.getDefinitions(callHook->snapshotStatement()).chunks()) {
@@ -420,7 +424,7 @@ std::vector<MemoryLocation> SignatureAnalyzer::getUsedReturnValueLocations(const
 
     auto callHook = hooks_.getCallHook(call);
     auto function = call->basicBlock()->function();
-    auto &uses = *function2uses_.at(function);
+    auto &uses = *uses_.at(function);
 
     foreach (const auto &locationAndTerm, callHook->speculativeReturnValueTerms()) {
         MemoryLocation usedPart;
@@ -445,7 +449,7 @@ std::vector<MemoryLocation> SignatureAnalyzer::getUnusedReturnValueLocations(con
     auto returnHook = hooks_.getReturnHook(jump);
     auto function = jump->basicBlock()->function();
     auto &dataflow = *dataflows_.at(function);
-    auto &uses = *function2uses_.at(function);
+    auto &uses = *uses_.at(function);
     auto &liveness = *livenesses_.at(function);
 
     foreach (const auto &locationAndTerm, returnHook->speculativeReturnValueTerms()) {
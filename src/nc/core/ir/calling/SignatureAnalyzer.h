@@ -30,7 +30,7 @@ class Term;
 
 namespace dflow {
     class Dataflows;
-    class Uses;
+    class UsesMap;
 }
 
 namespace liveness {
@@ -52,6 +52,7 @@ class SignatureAnalyzer {
 
     Signatures &signatures_;
     const dflow::Dataflows &dataflows_;
+    const dflow::UsesMap &uses_;
     const Hooks &hooks_;
     const liveness::Livenesses &livenesses_;
     const CancellationToken &canceled_;
@@ -75,9 +76,6 @@ class SignatureAnalyzer {
     /** Mapping of terms that represent potential return values in the hooks to callee ids. */
     boost::unordered_map<const Term *, CalleeId> speculativeReturnValueTerm2calleeId_;
 
-    /** Mapping from a function to the term use information for this function. */
-    boost::unordered_map<const Function *, std::unique_ptr<dflow::Uses>> function2uses_;
-
     /** Mapping from a callee id to the list of its formal arguments. */
     boost::unordered_map<CalleeId, std::vector<MemoryLocation>> id2arguments_;
 
@@ -94,13 +92,15 @@ public:
      *
      * \param signatures An object where to store reconstructed signatures.
      * \param dataflows Dataflows.
+     * \param uses Use information computed from the dataflows.
      * \param hooks Hooks manager.
      * \param livenesses Livenesses.
      * \param canceled Cancellation token.
      * \param log Log token.
      */
-    SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows, const Hooks &hooks,
-                      const liveness::Livenesses &livenesses, const CancellationToken &canceled, const LogToken &log);
+    SignatureAnalyzer(Signatures &signatures, const dflow::Dataflows &dataflows, const dflow::UsesMap &uses,
+                      const Hooks &hooks, const liveness::Livenesses &livenesses, const CancellationToken &canceled,
+                      const LogToken &log);
 
     /**
      * Destructor.
@@ -115,11 +115,6 @@ private:
      */
     void computeMappings();
 
-    /**
-     * Precomputes uses information.
-     */
-    void computeUses();
-
     /**
      * Computes locations of arguments for all functions.
      */
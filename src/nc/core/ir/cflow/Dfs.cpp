@@ -24,9 +24,7 @@
 
 #include "Dfs.h"
 
-#include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
-#include <nc/common/Unreachable.h>
 
 #include "Edge.h"
 #include "Region.h"
@@ -39,44 +37,73 @@ namespace cflow {
 Dfs::Dfs(const cflow::Region *region) {
     assert(region != nullptr);
 
-    preordering_.reserve(region->nodes().size());
-    postordering_.reserve(region->nodes().size());
+    const auto &nodes = region->nodes();
+
+    preordering_.reserve(nodes.size());
+    postordering_.reserve(nodes.size());
+
+    node2index_.reserve(nodes.size());
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        node2index_[nodes[i]] = i;
+    }
+    discovered_.resize(nodes.size());
+    finished_.resize(nodes.size());
 
     visit(region->entry());
 
-    foreach (cflow::Node *node, region->nodes()) {
-        if (find(node2color_, node) == WHITE) {
-            visit(node);
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (!discovered_[i]) {
+            visit(nodes[i]);
         }
     }
 }
 
+void Dfs::discover(cflow::Node *node, std::size_t index) {
+    assert(!discovered_[index]);
+
+    discovered_[index] = true;
+    preordering_.push_back(node);
+}
+
 void Dfs::visit(cflow::Node *node) {
     assert(node != nullptr);
-    assert(find(node2color_, node) == WHITE);
 
-    node2color_[node] = GRAY;
-    preordering_.push_back(node);
+    /* A node on the stack and the number of its out edges already followed. */
+    struct Frame {
+        cflow::Node *node;
+        std::size_t index;
+        std::size_t nextEdge;
+    };
+
+    std::vector<Frame> stack;
+
+    auto index = getIndex(node);
+    discover(node, index);
+    stack.push_back(Frame{node, index, 0});
 
-    foreach (cflow::Edge *edge, node->outEdges()) {
-        switch (find(node2color_, edge->head())) {
-        case WHITE:
-            edge2type_[edge] = FORWARD;
-            visit(edge->head());
-            break;
-        case GRAY:
-            edge2type_[edge] = BACK;
-            break;
-        case BLACK:
-            edge2type_[edge] = CROSS;
-            break;
-        default:
-            unreachable();
+    while (!stack.empty()) {
+        auto &frame = stack.back();
+        const auto &outEdges = frame.node->outEdges();
+
+        if (frame.nextEdge < outEdges.size()) {
+            cflow::Edge *edge = outEdges[frame.nextEdge++];
+            auto headIndex = getIndex(edge->head());
+
+            if (!discovered_[headIndex]) {
+                edge2type_[edge] = FORWARD;
+                discover(edge->head(), headIndex);
+                stack.push_back(Frame{edge->head(), headIndex, 0});
+            } else if (!finished_[headIndex]) {
+                edge2type_[edge] = BACK;
+            } else {
+                edge2type_[edge] = CROSS;
+            }
+        } else {
+            finished_[frame.index] = true;
+            postordering_.push_back(frame.node);
+            stack.pop_back();
         }
     }
-
-    node2color_[node] = BLACK;
-    postordering_.push_back(node);
 }
 
 } // namespace cflow
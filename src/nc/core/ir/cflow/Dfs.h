@@ -44,16 +44,12 @@ class Region;
 /**
  * This class performs a depth-first search in a given region, sorts its
  * nodes topologically, detects back edges.
+ *
+ * The search uses an explicit stack, so that it does not overflow
+ * the thread's stack on huge regions.
  */
 class Dfs {
 public:
-    /** Node color. */
-    enum NodeColor {
-        WHITE,
-        GRAY,
-        BLACK
-    };
-
     /** Edge type. */
     enum EdgeType {
         UNKNOWN,
@@ -69,8 +65,14 @@ private:
     /** List of region nodes in the order of leaving. */
     std::vector<Node *> postordering_;
 
-    /** Mapping from a node to its color. */
-    boost::unordered_map<const Node *, NodeColor> node2color_;
+    /** Mapping from a node to its index in the region's list of nodes. */
+    boost::unordered_map<const Node *, std::size_t> node2index_;
+
+    /** Whether the node with the given index was discovered. */
+    std::vector<bool> discovered_;
+
+    /** Whether the node with the given index was left. */
+    std::vector<bool> finished_;
 
     /** Mapping from an edge to its type. */
     boost::unordered_map<const Edge *, EdgeType> edge2type_;
@@ -111,6 +113,22 @@ public:
      */
     EdgeType getEdgeType(const Edge *edge) const { return nc::find(edge2type_, edge, UNKNOWN); }
 
+    /**
+     * \return Number of nodes in the region.
+     */
+    std::size_t nodeCount() const { return discovered_.size(); }
+
+    /**
+     * \param node Valid pointer to a node.
+     *
+     * \return Index of the node in the region's list of nodes at the time of the search,
+     *         or nodeCount() if the node was not in the region then.
+     */
+    std::size_t getIndex(const Node *node) const {
+        auto i = node2index_.find(node);
+        return i != node2index_.end() ? i->second : nodeCount();
+    }
+
 private:
 
     /**
@@ -119,6 +137,14 @@ private:
      * \param node Valid pointer to a not yet visited node.
      */
     void visit(Node *node);
+
+    /**
+     * Marks the node as discovered and adds it to the preordering.
+     *
+     * \param node Valid pointer to a not yet visited node.
+     * \param index Index of the node.
+     */
+    void discover(Node *node, std::size_t index);
 };
 
 } // namespace cflow
@@ -36,7 +36,7 @@ namespace ir {
 namespace cflow {
 
 LoopExplorer::LoopExplorer(Node *entry, const Dfs &dfs):
-    entry_(entry)
+    entry_(entry), dfs_(dfs), gray_(dfs.nodeCount()), black_(dfs.nodeCount())
 {
     assert(entry != nullptr);
 
@@ -46,7 +46,7 @@ LoopExplorer::LoopExplorer(Node *entry, const Dfs &dfs):
      */
     foreach (Edge *edge, entry_->inEdges()) {
         if (dfs.getEdgeType(edge) == Dfs::BACK) {
-            if (find(node2color_, edge->tail()) == WHITE) {
+            if (!gray_[getIndex(edge->tail())]) {
                 backwardVisit(edge->tail());
             }
         }
@@ -57,38 +57,84 @@ LoopExplorer::LoopExplorer(Node *entry, const Dfs &dfs):
      * loop entry and paint them black. All the black nodes belong
      * to the loop.
      */
-    if (find(node2color_, entry_) == GRAY) {
+    if (gray_[getIndex(entry_)]) {
         forwardVisit(entry_);
     }
 }
 
+std::size_t LoopExplorer::getIndex(const Node *node) {
+    auto index = dfs_.getIndex(node);
+    if (index < dfs_.nodeCount()) {
+        return index;
+    }
+
+    /* The node was created by a reduction done after the DFS. */
+    auto i = newNode2index_.find(node);
+    if (i != newNode2index_.end()) {
+        return i->second;
+    }
+
+    index = gray_.size();
+    newNode2index_[node] = index;
+    gray_.push_back(false);
+    black_.push_back(false);
+
+    return index;
+}
+
 void LoopExplorer::backwardVisit(Node *node) {
     assert(node != nullptr);
-    assert(find(node2color_, node) == WHITE);
+    assert(!gray_[getIndex(node)]);
 
-    node2color_[node] = GRAY;
+    std::vector<Node *> stack;
 
-    if (node == entry_) {
-        return;
-    }
+    gray_[getIndex(node)] = true;
+    stack.push_back(node);
 
-    foreach (Edge *edge, node->inEdges()) {
-        if (find(node2color_, edge->tail()) == WHITE) {
-            backwardVisit(edge->tail());
+    while (!stack.empty()) {
+        node = stack.back();
+        stack.pop_back();
+
+        if (node == entry_) {
+            continue;
+        }
+
+        foreach (Edge *edge, node->inEdges()) {
+            auto index = getIndex(edge->tail());
+            if (!gray_[index]) {
+                gray_[index] = true;
+                stack.push_back(edge->tail());
+            }
         }
     }
 }
 
 void LoopExplorer::forwardVisit(Node *node) {
     assert(node != nullptr);
-    assert(find(node2color_, node) == GRAY);
+    assert(gray_[getIndex(node)] && !black_[getIndex(node)]);
 
-    node2color_[node] = BLACK;
+    /* A node on the stack and the number of its out edges already followed. */
+    std::vector<std::pair<Node *, std::size_t>> stack;
+
+    black_[getIndex(node)] = true;
     loopNodes_.push_back(node);
+    stack.push_back(std::make_pair(node, 0));
+
+    while (!stack.empty()) {
+        auto &top = stack.back();
+        const auto &outEdges = top.first->outEdges();
 
-    foreach (Edge *edge, node->outEdges()) {
-        if (find(node2color_, edge->head()) == GRAY) {
-            forwardVisit(edge->head());
+        if (top.second < outEdges.size()) {
+            Node *head = outEdges[top.second++]->head();
+            auto index = getIndex(head);
+
+            if (gray_[index] && !black_[index]) {
+                black_[index] = true;
+                loopNodes_.push_back(head);
+                stack.push_back(std::make_pair(head, 0));
+            }
+        } else {
+            stack.pop_back();
         }
     }
 }
@@ -43,18 +43,20 @@ class Node;
  * are expected to belong to the loop with the given node being its entry.
  */
 class LoopExplorer {
-    /** Node color. */
-    enum NodeColor {
-        WHITE,
-        GRAY,
-        BLACK
-    };
-
     /** Entry node of a potential loop. */
     Node *entry_;
 
-    /** Mapping from a node to its color. */
-    boost::unordered_map<Node *, NodeColor> node2color_;
+    /** DFS results, also giving the indices of the nodes. */
+    const Dfs &dfs_;
+
+    /** Whether the node with the given index was painted gray or black. */
+    std::vector<bool> gray_;
+
+    /** Whether the node with the given index was painted black. */
+    std::vector<bool> black_;
+
+    /** Indices of the nodes created after the DFS. */
+    boost::unordered_map<const Node *, std::size_t> newNode2index_;
 
     /* Nodes on cyclic paths from the entry to the entry. */
     std::vector<Node *> loopNodes_;
@@ -80,19 +82,26 @@ public:
 
 private:
     /**
-     * Visits given node and, if the node is not entry, recursively
-     * visits all its WHITE predecessors. All the visited nodes are
-     * painted GRAY.
+     * \param node Valid pointer to a node of the region.
+     *
+     * \return Index of the node in gray_ and black_.
+     */
+    std::size_t getIndex(const Node *node);
+
+    /**
+     * Visits given node and, if the node is not entry, transitively
+     * visits all its white predecessors. All the visited nodes are
+     * painted gray.
      *
-     * \param node Valid pointer to a WHITE node.
+     * \param node Valid pointer to a white node.
      */
     void backwardVisit(Node *node);
 
     /**
-     * Visits given node and recursively visits all its GRAY successors.
-     * All the visited nodes are painted BLACK.
+     * Visits given node and transitively visits all its gray successors
+     * in depth-first order. All the visited nodes are painted black.
      *
-     * \param node Valid pointer to a GRAY node.
+     * \param node Valid pointer to a gray node.
      */
     void forwardVisit(Node *node);
 };
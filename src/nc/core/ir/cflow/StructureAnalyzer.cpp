@@ -28,7 +28,9 @@
 #include <queue>
 
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
+#include <nc/common/Budget.h>
 #include <nc/common/Foreach.h>
 #include <nc/common/Range.h>
 #include <nc/common/make_unique.h>
@@ -60,66 +62,81 @@ void StructureAnalyzer::analyze(Region *region) {
     bool changed;
 
     do {
-        changed = false;
+        if (budget_ && budget_->isExhausted(ndfs_)) {
+            budgetExceeded_ = true;
+            return;
+        }
 
         /*
          * Classify edges, sort nodes topologically.
          */
         Dfs dfs(region);
+        ++ndfs_;
 
         /*
-         * Try to reduce various kinds of regions.
+         * Try to reduce various kinds of regions, in the order of priority.
+         * Each kind of reduction is tried at all the nodes in a single sweep.
+         * The DFS is recomputed only after a sweep has changed the region.
+         * Loops are found using the DFS results, which become stale after
+         * any reduction, so the DFS is recomputed after each loop.
          */
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceCompoundCondition(node)) {
-                changed = true;
-                break;
-            }
-        }
-        if (changed) {
-            continue;
-        }
+        changed =
+            sweep(dfs, [this](Node *node) { return reduceCompoundCondition(node); }) ||
+            sweep(dfs, [&](Node *node) { return reduceCyclic(node, dfs); }, true) ||
+            sweep(dfs, [this](Node *node) { return reduceBlock(node); }) ||
+            sweep(dfs, [this](Node *node) { return reduceConditional(node); }) ||
+            sweep(dfs, [this](Node *node) { return reduceSwitch(node) || reduceHopelessConditional(node); });
+    } while (changed);
+}
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceCyclic(node, dfs)) {
-                changed = true;
-                break;
-            }
-        }
-        if (changed) {
-            continue;
-        }
+bool StructureAnalyzer::sweep(const Dfs &dfs, const std::function<bool(Node *)> &reduce, bool stopAfterFirst) {
+    /*
+     * Nodes merged into subregions or having their edges redirected during this sweep.
+     * What the DFS knows about them is stale, and what was known about their
+     * neighbourhood before the sweep is no longer true. Reductions involving
+     * them are postponed until the next DFS.
+     */
+    boost::unordered_set<const Node *> touched;
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceBlock(node)) {
-                changed = true;
-                break;
-            }
+    auto isTouched = [&](const Node *node) -> bool {
+        if (nc::contains(touched, node)) {
+            return true;
         }
-        if (changed) {
-            continue;
+        foreach (const Edge *edge, node->inEdges()) {
+            if (nc::contains(touched, edge->tail())) {
+                return true;
+            }
         }
-
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceConditional(node)) {
-                changed = true;
-                break;
+        foreach (const Edge *edge, node->outEdges()) {
+            if (nc::contains(touched, edge->head())) {
+                return true;
             }
         }
-        if (changed) {
+        return false;
+    };
+
+    /* Nested sweeps, started by reduceCyclic(), only consume the nodes touched after this point. */
+    auto mark = touchedNodes_.size();
+    bool changed = false;
+
+    foreach (Node *node, dfs.postordering()) {
+        if (!touched.empty() && isTouched(node)) {
             continue;
         }
+        if (reduce(node)) {
+            changed = true;
+            ++nreductions_;
+
+            touched.insert(touchedNodes_.begin() + mark, touchedNodes_.end());
+            touchedNodes_.resize(mark);
 
-        foreach (Node *node, dfs.postordering()) {
-            if (reduceSwitch(node) || reduceHopelessConditional(node)) {
-                changed = true;
+            if (stopAfterFirst) {
                 break;
             }
         }
-        if (changed) {
-            continue;
-        }
-    } while (changed);
+    }
+
+    return changed;
 }
 
 bool StructureAnalyzer::reduceBlock(Node *entry) {
@@ -600,11 +617,15 @@ Region *StructureAnalyzer::insertSubregion(Region *region, std::unique_ptr<Regio
     std::vector<Node *> tails;
     std::vector<Node *> heads;
 
+    touchedNodes_.insert(touchedNodes_.end(), subregion->nodes().begin(), subregion->nodes().end());
+
     foreach (Node *node, subregion->nodes()) {
         foreach (Edge *edge, node->inEdges()) {
             assert(edge->tail()->parent() == region || edge->tail()->parent() == subregion.get());
 
             if (edge->tail()->parent() == region) {
+                touchedNodes_.push_back(edge->tail());
+
                 if (edge->head() == subregion->entry() && !nc::contains(tails, edge->tail())) {
                     edgesToSubregion.push_back(edge);
                     tails.push_back(edge->tail());
@@ -617,6 +638,8 @@ Region *StructureAnalyzer::insertSubregion(Region *region, std::unique_ptr<Regio
             assert(edge->head()->parent() == region || edge->head()->parent() == subregion.get());
 
             if (edge->head()->parent() == region) {
+                touchedNodes_.push_back(edge->head());
+
                 if (!nc::contains(heads, edge->head())) {
                     edgesFromSubregion.push_back(edge);
                     heads.push_back(edge->head());
@@ -638,6 +661,8 @@ Region *StructureAnalyzer::insertSubregion(Region *region, std::unique_ptr<Regio
         edge->setHead(nullptr);
     }
 
+    touchedNodes_.push_back(subregion.get());
+
     return graph_.addNode(std::move(subregion));
 }
 
@@ -25,9 +25,14 @@
 
 #include <nc/config.h>
 
+#include <functional>
 #include <memory>
+#include <vector>
 
 namespace nc {
+
+class Budget;
+
 namespace core {
 namespace ir {
 
@@ -52,6 +57,21 @@ class StructureAnalyzer {
     /** Dataflow information. */
     const dflow::Dataflow &dataflow_;
 
+    /** Nodes whose neighbourhood was changed by insertSubregion() and not yet seen by sweep(). */
+    std::vector<const Node *> touchedNodes_;
+
+    /** Number of depth-first searches done. */
+    std::size_t ndfs_;
+
+    /** Number of reductions done. */
+    std::size_t nreductions_;
+
+    /** Budget of the analysis. Can be nullptr. */
+    const Budget *budget_;
+
+    /** Whether the analysis was stopped for exceeding the budget. */
+    bool budgetExceeded_;
+
 public:
     /**
      * Class constructor.
@@ -60,14 +80,38 @@ public:
      * \param dataflow Dataflow information.
      */
     StructureAnalyzer(Graph &graph, const dflow::Dataflow &dataflow):
-        graph_(graph), dataflow_(dataflow)
+        graph_(graph), dataflow_(dataflow), ndfs_(0), nreductions_(0), budget_(nullptr), budgetExceeded_(false)
     {}
 
+    /**
+     * Sets the budget of the analysis. When it is exhausted, the analysis stops,
+     * leaving the rest of the graph unstructured.
+     * The number of iterations is the number of depth-first searches done.
+     *
+     * \param budget Pointer to the budget. Can be nullptr.
+     */
+    void setBudget(const Budget *budget) { budget_ = budget; }
+
     /**
      * Performs structural analysis on the graph.
      */
     void analyze();
 
+    /**
+     * \return Number of depth-first searches done by the analysis, in all regions.
+     */
+    std::size_t ndfs() const { return ndfs_; }
+
+    /**
+     * \return Number of reductions done by the analysis, in all regions.
+     */
+    std::size_t nreductions() const { return nreductions_; }
+
+    /**
+     * \return True iff the analysis was stopped for exceeding the budget.
+     */
+    bool budgetExceeded() const { return budgetExceeded_; }
+
 private:
     /**
      * Runs structural analysis in the region.
@@ -76,6 +120,23 @@ private:
      */
     void analyze(Region *region);
 
+    /**
+     * Tries to apply a reduction at all nodes of a region in DFS postorder.
+     * Nodes whose neighbourhood was changed by an earlier reduction
+     * in the same sweep are skipped: the next sweep will get to them.
+     *
+     * Reductions relying on the DFS results beyond the order of nodes
+     * (edge types, loop membership) must stop after the first success,
+     * because a reduction may change what is reachable from far away nodes.
+     *
+     * \param[in] dfs Depth-first search results for the region.
+     * \param[in] reduce Reduction: returns true if it reduced a region with the given entry.
+     * \param[in] stopAfterFirst Whether to stop after the first successful reduction.
+     *
+     * \return True if at least one region was reduced.
+     */
+    bool sweep(const Dfs &dfs, const std::function<bool(Node *)> &reduce, bool stopAfterFirst = false);
+
     /**
      * Tries to reduce block region ending in the node.
      *
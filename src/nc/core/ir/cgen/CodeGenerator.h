@@ -73,6 +73,7 @@ namespace cflow {
 
 namespace dflow {
     class Dataflows;
+    class UsesMap;
 }
 
 namespace liveness {
@@ -101,6 +102,7 @@ class CodeGenerator: boost::noncopyable {
     const calling::Hooks &hooks_;
     const calling::Signatures &signatures_;
     const dflow::Dataflows &dataflows_;
+    const dflow::UsesMap &uses_;
     const vars::Variables &variables_;
     const cflow::Graphs &graphs_;
     const liveness::Livenesses &livenesses_;
@@ -131,6 +133,7 @@ public:
      * \param[in] hooks Hooks manager.
      * \param[in] signatures Signatures of functions.
      * \param[in] dataflows Dataflow information for all functions.
+     * \param[in] uses Use information for all functions.
      * \param[in] variables Information about reconstructed variables.
      * \param[in] graphs Reduced control-flow graphs.
      * \param[in] livenesses Liveness information for all functions.
@@ -138,12 +141,12 @@ public:
      * \param[in] cancellationToken Cancellation token.
      */
     CodeGenerator(likec::Tree &tree, const image::Image &image, const Functions &functions, const calling::Hooks &hooks,
-        const calling::Signatures &signatures, const dflow::Dataflows &dataflows, const vars::Variables &variables,
-        const cflow::Graphs &graphs, const liveness::Livenesses &livenesses, const types::Types &types,
-        const CancellationToken &cancellationToken
+        const calling::Signatures &signatures, const dflow::Dataflows &dataflows, const dflow::UsesMap &uses,
+        const vars::Variables &variables, const cflow::Graphs &graphs, const liveness::Livenesses &livenesses,
+        const types::Types &types, const CancellationToken &cancellationToken
     ):
         tree_(tree), image_(image), functions_(functions), hooks_(hooks), signatures_(signatures),
-        dataflows_(dataflows), variables_(variables), graphs_(graphs), livenesses_(livenesses),
+        dataflows_(dataflows), uses_(uses), variables_(variables), graphs_(graphs), livenesses_(livenesses),
         types_(types), cancellationToken_(cancellationToken), nameGenerator_(image)
     {}
 
@@ -177,6 +180,11 @@ public:
      */
     const ir::dflow::Dataflows &dataflows() const { return dataflows_; }
 
+    /**
+     * \return Use information for all functions not exceeding their budget.
+     */
+    const ir::dflow::UsesMap &uses() const { return uses_; }
+
     /**
      * \return Reconstructed variables.
      */
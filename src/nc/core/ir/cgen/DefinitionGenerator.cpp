@@ -54,6 +54,7 @@
 #include <nc/core/ir/cflow/Switch.h>
 #include <nc/core/ir/dflow/Dataflows.h>
 #include <nc/core/ir/dflow/Uses.h>
+#include <nc/core/ir/dflow/UsesMap.h>
 #include <nc/core/ir/dflow/Utils.h>
 #include <nc/core/ir/dflow/Value.h>
 #include <nc/core/ir/liveness/Livenesses.h>
@@ -90,6 +91,7 @@
 
 #include "SwitchContext.h"
 #include "Utils.h"
+#include "WriteIndex.h"
 
 namespace nc {
 namespace core {
@@ -102,9 +104,11 @@ DefinitionGenerator::DefinitionGenerator(CodeGenerator &parent, const Function *
     dataflow_(*parent.dataflows().at(function)),
     graph_(*parent.graphs().at(function)),
     liveness_(*parent.livenesses().at(function)),
-    uses_(std::make_unique<dflow::Uses>(dataflow_)),
+    ownUses_(nc::contains(parent.uses(), function) ? nullptr : std::make_unique<dflow::Uses>(dataflow_)),
+    uses_(ownUses_ ? *ownUses_ : *parent.uses().at(function)),
     cfg_(std::make_unique<CFG>(function->basicBlocks())),
     dominators_(std::make_unique<Dominators>(*cfg_, canceled)),
+    writeIndex_(std::make_unique<WriteIndex>(*cfg_, parent.variables())),
     hookStatements_(getHookStatements(function, dataflow_, parent.hooks())),
     definition_(nullptr)
 {
@@ -122,6 +126,13 @@ void DefinitionGenerator::setDefinition(likec::FunctionDefinition *definition) {
 std::unique_ptr<likec::FunctionDefinition> DefinitionGenerator::createDefinition() {
     auto nameAndComment = parent().nameGenerator().getFunctionName(function_);
 
+    if (function_->isDegraded()) {
+        if (!nameAndComment.comment().isEmpty()) {
+            nameAndComment.comment() += '\n';
+        }
+        nameAndComment.comment() += QLatin1String("Decompiled partially: the function exceeds its analysis budget.");
+    }
+
     auto functionDefinition = std::make_unique<likec::FunctionDefinition>(tree(),
         std::move(nameAndComment.name()), makeReturnType(), signature()->variadic());
 
@@ -766,6 +777,7 @@ std::unique_ptr<likec::Statement> DefinitionGenerator::makeJump(const Jump *jump
             }
             return std::make_unique<likec::Return>();
         }
+
         return std::make_unique<likec::Goto>(makeExpression(target.address()));
     } else {
         return std::make_unique<likec::Goto>(std::make_unique<likec::String>(QLatin1String("???")));
@@ -1259,7 +1271,7 @@ bool DefinitionGenerator::computeIsSubstituted(const Term *write) {
 
     std::size_t nuses = 0;
 
-    foreach (const auto &use, uses_->getUses(write)) {
+    foreach (const auto &use, uses_.getUses(write)) {
         auto read = use.term();
 
         if (liveness_.isLive(read)) {
@@ -1331,21 +1343,10 @@ bool DefinitionGenerator::canBeMoved(const Term *term, const Statement *destinat
                  * cannot always be the case.
                  */
                 return variable->isLocal() &&
-                     allOfStatementsBetween(
-                        term->statement(), destination, *cfg_,
-                        [&](const Statement *statement) -> bool {
-                            auto term = getWrittenTerm(statement);
-                            return !term || parent().variables().getVariable(term) != variable;
-                        }) == true;
+                    writeIndex_->isNotWrittenBetween(term->statement(), destination, variable);
             }
 
-            Domain domain = *getDomain(term);
-            return allOfStatementsBetween(
-                term->statement(), destination, *cfg_,
-                [&](const Statement *statement) -> bool {
-                    auto term = getWrittenTerm(statement);
-                    return !term || getDomain(term) != domain;
-                }) == true;
+            return writeIndex_->isNotWrittenBetween(term->statement(), destination, *getDomain(term));
         }
         case Term::UNARY_OPERATOR: {
             auto unary = term->asUnaryOperator();
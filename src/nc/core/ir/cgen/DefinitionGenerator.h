@@ -77,6 +77,7 @@ namespace liveness {
 namespace cgen {
 
 class SwitchContext;
+class WriteIndex;
 
 /**
  * Generator of function definitions.
@@ -86,9 +87,11 @@ class DefinitionGenerator: public DeclarationGenerator {
     const dflow::Dataflow &dataflow_;
     const cflow::Graph &graph_;
     const liveness::Liveness &liveness_;
-    std::unique_ptr<dflow::Uses> uses_;
+    std::unique_ptr<const dflow::Uses> ownUses_; ///< Uses computed for a function missing from the parent's uses. Can be nullptr.
+    const dflow::Uses &uses_;
     std::unique_ptr<CFG> cfg_;
     std::unique_ptr<Dominators> dominators_;
+    std::unique_ptr<WriteIndex> writeIndex_;
     boost::unordered_set<const Statement *> hookStatements_;
 
     likec::FunctionDefinition *definition_;
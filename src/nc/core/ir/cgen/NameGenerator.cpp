@@ -13,7 +13,6 @@
 #include <nc/core/ir/MemoryLocation.h>
 #include <nc/core/ir/Terms.h>
 #include <nc/core/ir/calling/CalleeId.h>
-#include <nc/core/mangling/Demangler.h>
 
 namespace nc {
 namespace core {
@@ -51,6 +50,11 @@ NameAndComment NameGenerator::getFunctionName(ByteAddr addr) const {
 NameAndComment NameGenerator::getFunctionName(const image::Symbol *symbol) const {
     assert(symbol != nullptr);
 
+    auto i = symbol2functionName_.find(symbol);
+    if (i != symbol2functionName_.end()) {
+        return i->second;
+    }
+
     QString name = cleanName(symbol->name());
     QString comment;
 
@@ -59,13 +63,16 @@ NameAndComment NameGenerator::getFunctionName(const image::Symbol *symbol) const
         comment += '\n';
     }
 
-    auto demangledName = image_.demangler()->demangle(symbol->name());
+    auto demangledName = image_.getDemangledName(symbol);
     if (demangledName.contains('(')) {
         comment += demangledName;
         comment += '\n';
     }
 
-    return NameAndComment(std::move(name), comment.trimmed());
+    NameAndComment result(std::move(name), comment.trimmed());
+    symbol2functionName_[symbol] = result;
+
+    return result;
 }
 
 NameAndComment NameGenerator::getGlobalVariableName(const MemoryLocation &memoryLocation) const {
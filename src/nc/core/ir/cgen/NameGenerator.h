@@ -5,6 +5,8 @@
 
 #include <nc/config.h>
 
+#include <boost/unordered_map.hpp>
+
 #include <QCoreApplication>
 #include <QString>
 
@@ -52,6 +54,10 @@ class NameGenerator {
     Q_DECLARE_TR_FUNCTIONS(NameGenerator)
 
     const image::Image &image_;
+
+    /** Cached names of functions given by symbols. */
+    mutable boost::unordered_map<const image::Symbol *, NameAndComment> symbol2functionName_;
+
 public:
     NameGenerator(const image::Image &image): image_(image) {}
 
@@ -0,0 +1,191 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#include "WriteIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+#include <nc/common/Foreach.h>
+#include <nc/common/Range.h>
+#include <nc/core/ir/BasicBlock.h>
+#include <nc/core/ir/CFG.h>
+#include <nc/core/ir/Statement.h>
+#include <nc/core/ir/vars/Variables.h>
+
+#include "Utils.h"
+
+namespace nc {
+namespace core {
+namespace ir {
+namespace cgen {
+
+WriteIndex::WriteIndex(const CFG &cfg, const vars::Variables &variables) {
+    foreach (auto basicBlock, cfg.basicBlocks()) {
+        block2index_[basicBlock] = blocks_.size();
+        blocks_.push_back(basicBlock);
+    }
+
+    writes_.resize(blocks_.size());
+    successors_.resize(blocks_.size());
+    predecessors_.resize(blocks_.size());
+
+    for (std::size_t i = 0; i < blocks_.size(); ++i) {
+        std::size_t position = 0;
+
+        foreach (auto statement, blocks_[i]->statements()) {
+            statement2position_[statement] = position;
+
+            if (auto term = getWrittenTerm(statement)) {
+                if (auto variable = variables.getVariable(term)) {
+                    auto key = variable2key_.insert(std::make_pair(variable, variable2key_.size() + domain2key_.size())).first->second;
+                    writes_[i].push_back(std::make_pair(key, position));
+                }
+                if (auto domain = getDomain(term)) {
+                    auto key = domain2key_.insert(std::make_pair(*domain, variable2key_.size() + domain2key_.size())).first->second;
+                    writes_[i].push_back(std::make_pair(key, position));
+                }
+            }
+
+            ++position;
+        }
+
+        std::sort(writes_[i].begin(), writes_[i].end());
+
+        /* Successors outside the CFG cannot lead back into it. */
+        foreach (auto successor, cfg.getSuccessors(blocks_[i])) {
+            auto j = block2index_.find(successor);
+            if (j != block2index_.end()) {
+                successors_[i].push_back(j->second);
+                predecessors_[j->second].push_back(i);
+            }
+        }
+    }
+}
+
+bool WriteIndex::isNotWrittenBetween(const Statement *first, const Statement *second, const vars::Variable *variable) {
+    assert(variable != nullptr);
+
+    auto i = variable2key_.find(variable);
+    return isNotWrittenBetween(first, second, i != variable2key_.end() ? boost::make_optional(i->second) : boost::none);
+}
+
+bool WriteIndex::isNotWrittenBetween(const Statement *first, const Statement *second, Domain domain) {
+    auto i = domain2key_.find(domain);
+    return isNotWrittenBetween(first, second, i != domain2key_.end() ? boost::make_optional(i->second) : boost::none);
+}
+
+bool WriteIndex::isNotWrittenBetween(const Statement *first, const Statement *second, const boost::optional<Key> &key) {
+    assert(first != nullptr);
+    assert(second != nullptr);
+    assert(nc::contains(statement2position_, first));
+    assert(nc::contains(statement2position_, second));
+
+    auto firstBlock = nc::find(block2index_, first->basicBlock());
+    auto secondBlock = nc::find(block2index_, second->basicBlock());
+    auto firstPosition = nc::find(statement2position_, first);
+    auto secondPosition = nc::find(statement2position_, second);
+
+    if (firstBlock == secondBlock) {
+        if (firstPosition < secondPosition) {
+            return !key || !isWritten(firstBlock, *key, firstPosition, secondPosition);
+        }
+        return false;
+    }
+
+    const auto &writesBetween = getWritesBetween(firstBlock, secondBlock);
+    if (!writesBetween) {
+        return false;
+    }
+
+    return !key ||
+        (!std::binary_search(writesBetween->begin(), writesBetween->end(), *key) &&
+         !isWritten(firstBlock, *key, firstPosition + 1, std::numeric_limits<std::size_t>::max()) &&
+         !isWritten(secondBlock, *key, 0, secondPosition));
+}
+
+bool WriteIndex::isWritten(std::size_t block, Key key, std::size_t begin, std::size_t end) const {
+    const auto &writes = writes_[block];
+    auto i = std::lower_bound(writes.begin(), writes.end(), std::make_pair(key, begin));
+    return i != writes.end() && i->first == key && i->second < end;
+}
+
+const boost::optional<std::vector<WriteIndex::Key>> &WriteIndex::getWritesBetween(std::size_t first, std::size_t second) {
+    auto pair = std::make_pair(first, second);
+
+    auto i = writesBetween_.find(pair);
+    if (i != writesBetween_.end()) {
+        return i->second;
+    }
+
+    auto &result = writesBetween_[pair];
+
+    enum Color {
+        WHITE,
+        GRAY,
+        BLACK
+    };
+
+    std::vector<Color> colors(blocks_.size(), WHITE);
+    std::queue<std::size_t> queue;
+
+    /*
+     * Find the basic blocks reachable from the first one without going through the second one.
+     */
+    queue.push(first);
+    colors[first] = GRAY;
+
+    while (!queue.empty()) {
+        foreach (auto successor, successors_[queue.front()]) {
+            if (colors[successor] == WHITE) {
+                if (successor != second) {
+                    queue.push(successor);
+                }
+                colors[successor] = GRAY;
+            }
+        }
+        queue.pop();
+    }
+
+    if (colors[second] == WHITE) {
+        return result;
+    }
+
+    /*
+     * Of them, find the ones from which the second one is reachable
+     * without going through the first one. Collect their writes.
+     */
+    std::vector<Key> keys;
+
+    queue.push(second);
+    colors[second] = BLACK;
+
+    while (!queue.empty()) {
+        foreach (auto predecessor, predecessors_[queue.front()]) {
+            if (colors[predecessor] == GRAY) {
+                if (predecessor != first) {
+                    foreach (const auto &write, writes_[predecessor]) {
+                        keys.push_back(write.first);
+                    }
+                    queue.push(predecessor);
+                }
+                colors[predecessor] = BLACK;
+            }
+        }
+        queue.pop();
+    }
+
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    result = std::move(keys);
+    return result;
+}
+
+} // namespace cgen
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
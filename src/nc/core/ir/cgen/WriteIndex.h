@@ -0,0 +1,142 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <utility>
+#include <vector>
+
+#include <boost/optional.hpp>
+#include <boost/unordered_map.hpp>
+
+#include <nc/core/ir/MemoryDomain.h>
+
+namespace nc {
+namespace core {
+namespace ir {
+
+class BasicBlock;
+class CFG;
+class Statement;
+
+namespace vars {
+    class Variable;
+    class Variables;
+}
+
+namespace cgen {
+
+/**
+ * Index of the writes to variables and memory domains done by the
+ * statements of a CFG, answering whether something is written between
+ * two statements.
+ *
+ * Statements lying between two statements are the same as those
+ * checked by allOfStatementsBetween(). Positions of statements in
+ * their basic blocks and the writes done by each basic block are
+ * computed once. The set of things written by the basic blocks
+ * between two given basic blocks is computed once for each pair.
+ */
+class WriteIndex {
+    /** Key of a written variable or memory domain. */
+    typedef std::size_t Key;
+
+    /** Mapping from a basic block to its index. */
+    boost::unordered_map<const BasicBlock *, std::size_t> block2index_;
+
+    /** Basic blocks by their indices. */
+    std::vector<const BasicBlock *> blocks_;
+
+    /** Mapping from a statement to its position in its basic block. */
+    boost::unordered_map<const Statement *, std::size_t> statement2position_;
+
+    /** Keys of written variables. */
+    boost::unordered_map<const vars::Variable *, Key> variable2key_;
+
+    /** Keys of written memory domains. */
+    boost::unordered_map<Domain, Key> domain2key_;
+
+    /** For each basic block, sorted pairs of a written key and the position of the writing statement. */
+    std::vector<std::vector<std::pair<Key, std::size_t>>> writes_;
+
+    /**
+     * Mapping from a pair of indices of basic blocks to the sorted keys
+     * written by the basic blocks between them, or boost::none if there
+     * is no path between the basic blocks.
+     */
+    boost::unordered_map<std::pair<std::size_t, std::size_t>, boost::optional<std::vector<Key>>> writesBetween_;
+
+    /** Successors of basic blocks, as indices. */
+    std::vector<std::vector<std::size_t>> successors_;
+
+    /** Predecessors of basic blocks, as indices. */
+    std::vector<std::vector<std::size_t>> predecessors_;
+
+public:
+    /**
+     * Indexes the writes done in a CFG.
+     *
+     * \param cfg The CFG.
+     * \param variables Variables accessed by the statements of the CFG.
+     */
+    WriteIndex(const CFG &cfg, const vars::Variables &variables);
+
+    /**
+     * \param[in] first Valid pointer to a statement in the CFG.
+     * \param[in] second Valid pointer to a statement in the same CFG.
+     * \param[in] variable Valid pointer to a variable.
+     *
+     * \return True iff there is a path from the first statement to the second one
+     *         and the statements lying on such paths do not write to the variable.
+     */
+    bool isNotWrittenBetween(const Statement *first, const Statement *second, const vars::Variable *variable);
+
+    /**
+     * \param[in] first Valid pointer to a statement in the CFG.
+     * \param[in] second Valid pointer to a statement in the same CFG.
+     * \param[in] domain Memory domain.
+     *
+     * \return True iff there is a path from the first statement to the second one
+     *         and the statements lying on such paths do not write to the memory domain.
+     */
+    bool isNotWrittenBetween(const Statement *first, const Statement *second, Domain domain);
+
+private:
+    /**
+     * \param[in] first Valid pointer to a statement in the CFG.
+     * \param[in] second Valid pointer to a statement in the same CFG.
+     * \param[in] key Key of the written thing, or boost::none if it is never written.
+     *
+     * \return True iff there is a path from the first statement to the second one
+     *         and the statements lying on such paths do not write the key.
+     */
+    bool isNotWrittenBetween(const Statement *first, const Statement *second, const boost::optional<Key> &key);
+
+    /**
+     * \param block Index of a basic block.
+     * \param key Key of the written thing.
+     * \param begin Position of the first statement to check.
+     * \param end Position past the last statement to check.
+     *
+     * \return True iff one of the statements in the given range writes the key.
+     */
+    bool isWritten(std::size_t block, Key key, std::size_t begin, std::size_t end) const;
+
+    /**
+     * \param first Index of a basic block.
+     * \param second Index of a basic block.
+     *
+     * \return Sorted keys written by the basic blocks lying on the paths from the first
+     *         basic block to the second one, or boost::none if there is no such path.
+     */
+    const boost::optional<std::vector<Key>> &getWritesBetween(std::size_t first, std::size_t second);
+};
+
+} // namespace cgen
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
@@ -24,13 +24,14 @@
 
 #include "Dataflow.h"
 
-#include "Value.h"
-
 namespace nc {
 namespace core {
 namespace ir {
 namespace dflow {
 
+const MemoryLocation Dataflow::noLocation_;
+const ReachingDefinitions Dataflow::noDefinitions_;
+
 Dataflow::Dataflow() {}
 
 Dataflow::~Dataflow() {}
@@ -42,11 +43,13 @@ Value *Dataflow::getValue(const Term *term) {
         term = source;
     }
 
-    auto &result = term2value_[term];
-    if (!result) {
-        result.reset(new Value(term->size()));
+    if (auto result = term2value_.find(term)) {
+        return result;
     }
-    return result.get();
+
+    auto &result = term2value_[term];
+    result = Value(term->size());
+    return &result;
 }
 
 const Value *Dataflow::getValue(const Term *term) const {
@@ -25,39 +25,52 @@
 
 #include <nc/config.h>
 
-#include <memory>
-
-#include <boost/unordered_map.hpp>
-
-#include <nc/common/Range.h>
-
+#include <nc/core/ir/IdMap.h>
 #include <nc/core/ir/MemoryLocation.h>
+#include <nc/core/ir/Statement.h>
 #include <nc/core/ir/Term.h>
 
 #include "ReachingDefinitions.h"
+#include "Value.h"
 
 namespace nc {
 namespace core {
 namespace ir {
 namespace dflow {
 
-class Value;
-
 /**
  * This class contains results of dataflow and constant propagation and folding analysis.
+ *
+ * The results are stored in vectors indexed by the ids of terms and statements.
+ * Therefore, all the terms and statements passed to the methods of this class
+ * must be numbered by the same Numbering object, which is normally the numbering
+ * of the function they belong to.
  */
 class Dataflow {
+public:
+    typedef IdMap<Term, Value> Term2Value;
+    typedef IdMap<Term, MemoryLocation> Term2Location;
+    typedef IdMap<Term, ReachingDefinitions> Term2Definitions;
+    typedef IdMap<Statement, ReachingDefinitions> Statement2Definitions;
+
+private:
     /** Mapping from a term to a description of its value. */
-    boost::unordered_map<const Term *, std::unique_ptr<Value>> term2value_;
+    Term2Value term2value_;
 
     /** Mapping from a term to its memory location. */
-    boost::unordered_map<const Term *, MemoryLocation> term2location_;
+    Term2Location term2location_;
 
     /** Mapping from a term to the reaching definitions. */
-    boost::unordered_map<const Term *, ReachingDefinitions> term2definitions_;
+    Term2Definitions term2definitions_;
 
     /** Mapping from a statement to the reaching definitions. */
-    boost::unordered_map<const Statement *, ReachingDefinitions> statement2definitions_;
+    Statement2Definitions statement2definitions_;
+
+    /** Invalid memory location returned for terms without a location. */
+    static const MemoryLocation noLocation_;
+
+    /** Empty definitions returned for terms and statements without definitions. */
+    static const ReachingDefinitions noDefinitions_;
 
 public:
     /**
@@ -91,12 +104,12 @@ public:
     /**
      * \return Mapping from a term to the description of its value.
      */
-    boost::unordered_map<const Term *, std::unique_ptr<Value>> &term2value() { return term2value_; }
+    Term2Value &term2value() { return term2value_; }
 
     /**
      * \return Mapping from a term to the description of its value.
      */
-    const boost::unordered_map<const Term *, std::unique_ptr<Value>> &term2value() const { return term2value_; }
+    const Term2Value &term2value() const { return term2value_; }
 
     /**
      * \param[in] term Valid pointer to a term.
@@ -106,7 +119,8 @@ public:
      */
     const ir::MemoryLocation &getMemoryLocation(const Term *term) const {
         assert(term != nullptr);
-        return nc::find(term2location_, term);
+        auto result = term2location_.find(term);
+        return result ? *result : noLocation_;
     }
 
     /**
@@ -125,12 +139,12 @@ public:
     /**
      * \return Mapping from a term to its memory location.
      */
-    boost::unordered_map<const Term *, MemoryLocation> &term2location() { return term2location_; };
+    Term2Location &term2location() { return term2location_; };
 
     /**
      * \return Mapping from a term to its memory location.
      */
-    const boost::unordered_map<const Term *, MemoryLocation> &term2location() const { return term2location_; };
+    const Term2Location &term2location() const { return term2location_; };
 
     /**
      * \param[in] term Valid pointer to a read term.
@@ -151,18 +165,19 @@ public:
     const ReachingDefinitions &getDefinitions(const Term *term) const {
         assert(term != nullptr);
         assert(term->isRead());
-        return nc::find(term2definitions_, term);
+        auto result = term2definitions_.find(term);
+        return result ? *result : noDefinitions_;
     }
 
     /**
      * \return Mapping from a term to its reaching definitions.
      */
-    boost::unordered_map<const Term *, ReachingDefinitions> &term2definitions() { return term2definitions_; }
+    Term2Definitions &term2definitions() { return term2definitions_; }
 
     /**
      * \return Mapping from a term to its reaching definitions.
      */
-    const boost::unordered_map<const Term *, ReachingDefinitions> &term2definitions() const { return term2definitions_; }
+    const Term2Definitions &term2definitions() const { return term2definitions_; }
 
     /**
      * \param[in] statement Valid pointer to a read statement.
@@ -181,8 +196,19 @@ public:
      */
     const ReachingDefinitions &getDefinitions(const Statement *statement) const {
         assert(statement != nullptr);
-        return nc::find(statement2definitions_, statement);
+        auto result = statement2definitions_.find(statement);
+        return result ? *result : noDefinitions_;
     }
+
+    /**
+     * \return Mapping from a statement to the reaching definitions.
+     */
+    Statement2Definitions &statement2definitions() { return statement2definitions_; }
+
+    /**
+     * \return Mapping from a statement to the reaching definitions.
+     */
+    const Statement2Definitions &statement2definitions() const { return statement2definitions_; }
 };
 
 } // namespace dflow
@@ -24,7 +24,13 @@
 
 #include "DataflowAnalyzer.h"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+
+#include <boost/optional.hpp>
 #include <boost/unordered_map.hpp>
+#include <boost/unordered_set.hpp>
 
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
@@ -62,6 +68,57 @@ void remove_if(Map &map, Pred pred) {
     }
 }
 
+/**
+ * \param cfg Control flow graph.
+ *
+ * \return Basic blocks of the graph in reverse postorder.
+ *         Depth-first searches are started from the basic blocks
+ *         in the order in which the graph lists them.
+ */
+std::vector<const BasicBlock *> getReversePostorder(const CFG &cfg) {
+    std::vector<const BasicBlock *> result;
+
+    /* Dense numbering of the graph's basic blocks. */
+    boost::unordered_map<const BasicBlock *, std::size_t> block2index;
+    foreach (const BasicBlock *basicBlock, cfg.basicBlocks()) {
+        block2index.emplace(basicBlock, block2index.size());
+    }
+
+    std::vector<bool> visited(block2index.size());
+
+    /* Stack of basic blocks being visited and indices of their next successors. */
+    std::vector<std::pair<const BasicBlock *, std::size_t>> stack;
+
+    foreach (const BasicBlock *root, cfg.basicBlocks()) {
+        auto rootIndex = block2index[root];
+        if (visited[rootIndex]) {
+            continue;
+        }
+        visited[rootIndex] = true;
+        stack.push_back(std::make_pair(root, 0));
+
+        while (!stack.empty()) {
+            const BasicBlock *basicBlock = stack.back().first;
+            const auto &successors = cfg.getSuccessors(basicBlock);
+
+            if (stack.back().second < successors.size()) {
+                const BasicBlock *successor = successors[stack.back().second++];
+                auto i = block2index.find(successor);
+                if (i != block2index.end() && !visited[i->second]) {
+                    visited[i->second] = true;
+                    stack.push_back(std::make_pair(successor, 0));
+                }
+            } else {
+                result.push_back(basicBlock);
+                stack.pop_back();
+            }
+        }
+    }
+
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
 } // anonymous namespace
 
 void DataflowAnalyzer::analyze(const CFG &cfg) {
@@ -72,61 +129,193 @@ void DataflowAnalyzer::analyze(const CFG &cfg) {
         return !dataflow().getMemoryLocation(term).covers(mloc);
     };
 
-    /* Mapping of a basic block to the definitions reaching its end. */
-    boost::unordered_map<const BasicBlock *, ReachingDefinitions> outDefinitions;
+    /*
+     * Basic blocks in reverse postorder and the mapping back to their indices.
+     */
+    std::vector<const BasicBlock *> basicBlocks = getReversePostorder(cfg);
+
+    boost::unordered_map<const BasicBlock *, std::size_t> block2index;
+    for (std::size_t i = 0; i < basicBlocks.size(); ++i) {
+        block2index[basicBlocks[i]] = i;
+    }
+
+    /* Definitions reaching the beginning of a basic block, before filtering. */
+    std::vector<ReachingDefinitions> inDefinitions(basicBlocks.size());
+
+    /* Definitions reaching the end of a basic block. */
+    std::vector<ReachingDefinitions> outDefinitions(basicBlocks.size());
+
+    /* Number of times each basic block was executed. */
+    std::vector<std::size_t> nexecutions(basicBlocks.size());
+
+    /* Mapping of a term to the indices of basic blocks that its definition reaches. */
+    IdMap<Term, std::vector<std::size_t>> term2readers;
+
+    /* Pairs of a term id and a basic block index already recorded in term2readers. */
+    boost::unordered_set<std::pair<std::size_t, std::size_t>> recordedReaders;
+
+    /* Value and memory location of a written term as of the last execution of its basic block. */
+    IdMap<Term, std::pair<Value, MemoryLocation>> term2snapshot;
+
+    /*
+     * Worklist of basic blocks, the first in reverse postorder goes first.
+     */
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> worklist;
+    std::vector<char> queued(basicBlocks.size(), true);
+
+    for (std::size_t i = 0; i < basicBlocks.size(); ++i) {
+        worklist.push(i);
+    }
+
+    auto enqueue = [&](std::size_t index) {
+        if (!queued[index]) {
+            queued[index] = true;
+            worklist.push(index);
+        }
+    };
+
+    niterations_ = 0;
+    nblockExecutions_ = 0;
+    budgetExceeded_ = false;
 
     /*
-     * Running abstract interpretation until reaching a fixpoint several times in a row.
+     * Do we loop infinitely? Allow on average 30 executions of each basic block.
      */
-    int niterations = 0;
-    int nfixpoints = 0;
+    const std::size_t maxBlockExecutions = 30 * basicBlocks.size();
+
+    std::vector<const Term *> writtenTerms;
+
+    /* Whether the time budget is exceeded, so that all basic blocks are executed with widening. */
+    bool widenAll = false;
+
+    while (!worklist.empty()) {
+        if (nblockExecutions_ >= maxBlockExecutions) {
+            log_.warning(tr("%1: Fixpoint was not reached after %2 executions of basic blocks.")
+                .arg(Q_FUNC_INFO).arg(nblockExecutions_));
+            break;
+        }
+
+        if (!widenAll && budget_ && budget_->isTimeExceeded()) {
+            log_.debug(tr("%1: Time budget exceeded after %2 executions of basic blocks, widening.")
+                .arg(Q_FUNC_INFO).arg(nblockExecutions_));
+            budgetExceeded_ = true;
+            widenAll = true;
+        }
+
+        std::size_t index = worklist.top();
+        worklist.pop();
+        queued[index] = false;
 
-    while (nfixpoints++ < 3) {
         /*
-         * Run abstract interpretation on all basic blocks.
+         * Basic blocks that have used up their iterations are still executed
+         * until the fixpoint is reached, so that all the definitions reaching
+         * their terms are found, but the values of their reads are widened.
          */
-        foreach (auto basicBlock, cfg.basicBlocks()) {
-            ReachingDefinitions definitions;
-
-            /* Merge reaching definitions from predecessors. */
-            foreach (const BasicBlock *predecessor, cfg.getPredecessors(basicBlock)) {
-                definitions.merge(outDefinitions[predecessor]);
+        widen_ = false;
+        if (nexecutions[index] > 0) {
+            if (widenAll) {
+                widen_ = true;
+            } else if (budget_ && budget_->isIterationLimitReached(nexecutions[index])) {
+                budgetExceeded_ = true;
+                widen_ = true;
             }
+        }
+
+        auto basicBlock = basicBlocks[index];
 
-            /* Remove definitions that do not cover the memory location that they define. */
-            definitions.filterOut(notCovered);
+        ++nblockExecutions_;
+        niterations_ = std::max(niterations_, ++nexecutions[index]);
 
-            /* Execute all the statements in the basic block. */
-            foreach (auto statement, basicBlock->statements()) {
-                execute(statement, definitions);
+        ReachingDefinitions definitions;
+
+        /* Merge reaching definitions from predecessors. */
+        foreach (const BasicBlock *predecessor, cfg.getPredecessors(basicBlock)) {
+            auto i = block2index.find(predecessor);
+            if (i != block2index.end()) {
+                definitions.merge(outDefinitions[i->second]);
             }
+        }
 
-            /* Something has changed? */
-            ReachingDefinitions &oldDefinitions(outDefinitions[basicBlock]);
-            if (oldDefinitions != definitions) {
-                oldDefinitions = std::move(definitions);
-                nfixpoints = 0;
+        /* Remember which basic blocks depend on which definitions. */
+        if (definitions != inDefinitions[index]) {
+            foreach (const auto &chunk, definitions.chunks()) {
+                foreach (const Term *term, chunk.definitions()) {
+                    if (recordedReaders.insert(std::make_pair(term->id(), index)).second) {
+                        term2readers[term].push_back(index);
+                    }
+                }
             }
+            inDefinitions[index] = definitions;
         }
 
-        /*
-         * Some terms might have changed their addresses. Filter again.
-         */
-        foreach (auto &termAndDefinitions, dataflow().term2definitions()) {
-            termAndDefinitions.second.filterOut(notCovered);
+        /* Remove definitions that do not cover the memory location that they define. */
+        definitions.filterOut(notCovered);
+
+        /* Execute all the statements in the basic block. */
+        foreach (auto statement, basicBlock->statements()) {
+            execute(statement, definitions);
         }
 
-        /*
-         * Do we loop infinitely?
-         */
-        if (++niterations >= 30) {
-            log_.warning(tr("%1: Fixpoint was not reached after %2 iterations.").arg(Q_FUNC_INFO).arg(niterations));
-            break;
+        /* Blocks reached by definitions whose values or locations changed must be rerun. */
+        writtenTerms.clear();
+        foreach (auto statement, basicBlock->statements()) {
+            if (auto assignment = statement->asAssignment()) {
+                writtenTerms.push_back(assignment->left());
+            } else if (auto touch = statement->asTouch()) {
+                if (touch->accessType() == Term::WRITE) {
+                    writtenTerms.push_back(touch->term());
+                }
+            }
+        }
+
+        foreach (const Term *term, writtenTerms) {
+            const Value &value = *dataflow().getValue(term);
+            const MemoryLocation &memoryLocation = dataflow().getMemoryLocation(term);
+
+            auto snapshot = term2snapshot.find(term);
+            if (!snapshot) {
+                term2snapshot[term] = std::make_pair(value, memoryLocation);
+            } else if (snapshot->first != value || !(snapshot->second == memoryLocation)) {
+                snapshot->first = value;
+                snapshot->second = memoryLocation;
+            } else {
+                continue;
+            }
+
+            if (auto readers = term2readers.find(term)) {
+                foreach (std::size_t reader, *readers) {
+                    enqueue(reader);
+                }
+            }
+        }
+
+        /* Something has changed? */
+        if (outDefinitions[index] != definitions) {
+            outDefinitions[index] = std::move(definitions);
+
+            foreach (const BasicBlock *successor, cfg.getSuccessors(basicBlock)) {
+                auto i = block2index.find(successor);
+                if (i != block2index.end()) {
+                    enqueue(i->second);
+                }
+            }
         }
 
         canceled_.poll();
     }
 
+    widen_ = false;
+
+    log_.debug(tr("%1: %2 basic blocks, %3 executions of basic blocks, at most %4 per block.")
+        .arg(Q_FUNC_INFO).arg(basicBlocks.size()).arg(nblockExecutions_).arg(niterations_));
+
+    /*
+     * Some terms might have changed their addresses. Filter again.
+     */
+    foreach (auto &termAndDefinitions, dataflow().term2definitions()) {
+        termAndDefinitions.second.filterOut(notCovered);
+    }
+
     /*
      * Remove information about terms that disappeared.
      * Terms can disappear if e.g. a call is deinstrumented during the analysis.
@@ -141,6 +330,18 @@ void DataflowAnalyzer::analyze(const CFG &cfg) {
     remove_if(dataflow().term2value(), disappeared);
     remove_if(dataflow().term2location(), disappeared);
     remove_if(dataflow().term2definitions(), disappeared);
+
+    /*
+     * Statements can disappear too, e.g. callbacks deleted by deinstrumentation.
+     * Their keys may be dangling, so keep only the entries of present statements.
+     */
+    std::vector<const Statement *> statements;
+    foreach (auto basicBlock, cfg.basicBlocks()) {
+        foreach (auto statement, basicBlock->statements()) {
+            statements.push_back(statement);
+        }
+    }
+    dataflow().statement2definitions().retain(statements);
 }
 
 void DataflowAnalyzer::execute(const Statement *statement, ReachingDefinitions &definitions) {
@@ -336,6 +537,12 @@ Value *DataflowAnalyzer::computeValue(const Term *term, const MemoryLocation &me
         return value;
     }
 
+    /* Value computed by the previous execution, if it must be widened on change. */
+    boost::optional<Value> previousValue;
+    if (widen_) {
+        previousValue = *value;
+    }
+
     auto byteOrder = architecture()->getByteOrder(memoryLocation.domain());
 
     /*
@@ -433,6 +640,17 @@ Value *DataflowAnalyzer::computeValue(const Term *term, const MemoryLocation &me
         }
     }
 
+    /*
+     * A value that keeps changing after the budget is exhausted becomes
+     * completely unknown, so that it does not change any more.
+     */
+    if (previousValue && *value != *previousValue) {
+        value->setAbstractValue(AbstractValue(value->abstractValue().size(), -1, -1));
+        value->makeNotStackOffset();
+        value->makeNotProduct();
+        value->makeNotReturnAddress();
+    }
+
     return value;
 }
 
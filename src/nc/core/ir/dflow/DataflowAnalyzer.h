@@ -27,6 +27,7 @@
 
 #include <QCoreApplication>
 
+#include <nc/common/Budget.h>
 #include <nc/common/CancellationToken.h>
 #include <nc/common/LogToken.h>
 
@@ -66,6 +67,11 @@ class DataflowAnalyzer {
     const arch::Architecture *architecture_; ///< Valid pointer to architecture description.
     const CancellationToken &canceled_;
     const LogToken &log_;
+    std::size_t niterations_; ///< Maximal number of executions of a single basic block during the last analysis.
+    std::size_t nblockExecutions_; ///< Total number of executions of basic blocks during the last analysis.
+    const Budget *budget_; ///< Budget of the analysis. Can be nullptr.
+    bool budgetExceeded_; ///< Whether the last analysis exceeded the budget.
+    bool widen_; ///< Whether changing values of reads are widened during the current execution of a basic block.
 
 public:
     /**
@@ -78,7 +84,8 @@ public:
      */
     DataflowAnalyzer(Dataflow &dataflow, const arch::Architecture *architecture,
         const CancellationToken &canceled, const LogToken &log):
-        dataflow_(dataflow), architecture_(architecture), canceled_(canceled), log_(log)
+        dataflow_(dataflow), architecture_(architecture), canceled_(canceled), log_(log),
+        niterations_(0), nblockExecutions_(0), budget_(nullptr), budgetExceeded_(false), widen_(false)
     {
         assert(architecture != nullptr);
     }
@@ -93,14 +100,50 @@ public:
      */
     const arch::Architecture *architecture() const { return architecture_; }
 
+    /**
+     * Sets the budget of the analysis. A basic block executed as many times
+     * as the iteration limit, or any basic block once the time is over, is
+     * executed further with widening: the values of its reads that change
+     * become unknown. The analysis still runs to the fixpoint, so that the
+     * reaching definitions are complete and the remaining concrete values
+     * are correct, but it reaches the fixpoint quickly.
+     *
+     * \param budget Pointer to the budget. Can be nullptr.
+     */
+    void setBudget(const Budget *budget) { budget_ = budget; }
+
     /**
      * Performs joint reaching definitions and constant propagation/folding
      * analysis on the given control flow graph.
      *
+     * Basic blocks are kept in a worklist ordered by their reverse postorder
+     * numbers. A basic block is executed again only when the definitions
+     * reaching it, or the values or memory locations of these definitions,
+     * have changed. The analysis gives up after 30 * N executions of basic
+     * blocks in total, N being the number of reachable basic blocks.
+     *
      * \param[in] cfg Control flow graph to run dataflow analysis on.
      */
     void analyze(const CFG &cfg);
 
+    /**
+     * \return Maximal number of times a single basic block was executed
+     *         during the last call to analyze().
+     *         The iteration limit of the budget applies to this number.
+     */
+    std::size_t niterations() const { return niterations_; }
+
+    /**
+     * \return Total number of executions of basic blocks
+     *         during the last call to analyze().
+     */
+    std::size_t nblockExecutions() const { return nblockExecutions_; }
+
+    /**
+     * \return True iff the last call to analyze() exceeded the budget and widened values.
+     */
+    bool budgetExceeded() const { return budgetExceeded_; }
+
     /**
      * Executes a statement.
      *
@@ -56,38 +56,52 @@ void ReachingDefinitions::addDefinition(const MemoryLocation &mloc, const Term *
 void ReachingDefinitions::killDefinitions(const MemoryLocation &mloc) {
     assert(mloc);
 
-    if (chunks_.empty()) {
+    /*
+     * Chunks are sorted and do not overlap, therefore the chunks
+     * overlapping with the given location form a contiguous range.
+     */
+    auto first = std::partition_point(chunks_.begin(), chunks_.end(),
+        [&](const Chunk &chunk) -> bool {
+            return chunk.location().domain() < mloc.domain() ||
+                   (chunk.location().domain() == mloc.domain() && chunk.location().endAddr() <= mloc.addr());
+        });
+
+    auto last = std::partition_point(first, chunks_.end(),
+        [&](const Chunk &chunk) -> bool {
+            return chunk.location().domain() == mloc.domain() && chunk.location().addr() < mloc.endAddr();
+        });
+
+    if (first == last) {
         return;
     }
 
-    std::vector<Chunk> result;
-    result.reserve(chunks_.size() + 1);
-
-    foreach (auto &chunk, chunks_) {
-        if (!mloc.overlaps(chunk.location())) {
-            result.push_back(std::move(chunk));
-        } else {
-            if (chunk.location().addr() < mloc.addr()) {
-                if (mloc.endAddr() < chunk.location().endAddr()) {
-                    result.push_back(Chunk(
-                        MemoryLocation(mloc.domain(), chunk.location().addr(), mloc.addr() - chunk.location().addr()),
-                        chunk.definitions()));
-                } else {
-                    result.push_back(Chunk(
-                        MemoryLocation(mloc.domain(), chunk.location().addr(), mloc.addr() - chunk.location().addr()),
-                        std::move(chunk.definitions())));
-                }
-            }
-            if (mloc.endAddr() < chunk.location().endAddr()) {
-                result.push_back(Chunk(
-                    MemoryLocation(mloc.domain(), mloc.endAddr(), chunk.location().endAddr() - mloc.endAddr()),
-                    std::move(chunk.definitions())));
-            }
+    bool keepLeft = first->location().addr() < mloc.addr();
+    bool keepRight = mloc.endAddr() < (last - 1)->location().endAddr();
+
+    if (keepLeft && keepRight && last - first == 1) {
+        Chunk right(
+            MemoryLocation(mloc.domain(), mloc.endAddr(), first->location().endAddr() - mloc.endAddr()),
+            first->sharedDefinitions());
+        *first = Chunk(
+            MemoryLocation(mloc.domain(), first->location().addr(), mloc.addr() - first->location().addr()),
+            first->sharedDefinitions());
+        chunks_.insert(first + 1, std::move(right));
+    } else {
+        if (keepLeft) {
+            *first = Chunk(
+                MemoryLocation(mloc.domain(), first->location().addr(), mloc.addr() - first->location().addr()),
+                first->sharedDefinitions());
+            ++first;
+        }
+        if (keepRight) {
+            --last;
+            *last = Chunk(
+                MemoryLocation(mloc.domain(), mloc.endAddr(), last->location().endAddr() - mloc.endAddr()),
+                last->sharedDefinitions());
         }
+        chunks_.erase(first, last);
     }
 
-    chunks_ = std::move(result);
-
     selfTest();
 }
 
@@ -104,7 +118,7 @@ void ReachingDefinitions::project(const MemoryLocation &mloc, ReachingDefinition
             if (addr < endAddr) {
                 result.chunks_.push_back(Chunk(
                     MemoryLocation(mloc.domain(), addr, endAddr - addr),
-                    chunk.definitions()));
+                    chunk.sharedDefinitions()));
             }
         }
     }
@@ -125,9 +139,45 @@ std::vector<MemoryLocation> ReachingDefinitions::getDefinedMemoryLocationsWithin
     return result;
 }
 
+namespace {
+
+/**
+ * \param a Valid pointer to a sorted list of terms.
+ * \param b Valid pointer to a sorted list of terms.
+ *
+ * \return Valid pointer to the sorted union of the lists. If the union is equal
+ *         to one of the lists, the pointer to this list is returned.
+ */
+std::shared_ptr<const std::vector<const Term *>> unite(const std::shared_ptr<const std::vector<const Term *>> &a,
+                                                       const std::shared_ptr<const std::vector<const Term *>> &b)
+{
+    if (a == b || std::includes(a->begin(), a->end(), b->begin(), b->end())) {
+        return a;
+    }
+    if (std::includes(b->begin(), b->end(), a->begin(), a->end())) {
+        return b;
+    }
+
+    auto result = std::make_shared<std::vector<const Term *>>();
+    result->reserve(a->size() + b->size());
+    std::set_union(a->begin(), a->end(), b->begin(), b->end(), std::back_inserter(*result));
+
+    return result;
+}
+
+} // anonymous namespace
+
 void ReachingDefinitions::merge(const ReachingDefinitions &those) {
     selfTest();
 
+    if (those.chunks_.empty() || *this == those) {
+        return;
+    }
+    if (chunks_.empty()) {
+        chunks_ = those.chunks_;
+        return;
+    }
+
     std::vector<Chunk> result;
     result.reserve(chunks_.size() + those.chunks_.size());
 
@@ -152,31 +202,29 @@ void ReachingDefinitions::merge(const ReachingDefinitions &those) {
         }
 
         if (!b) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (!a) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.domain() < b.domain()) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (b.domain() < a.domain()) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.endAddr() <= b.addr()) {
-            result.push_back(Chunk(a, i->definitions()));
+            result.push_back(Chunk(a, i->sharedDefinitions()));
             ++i;
         } else if (b.endAddr() <= a.addr()) {
-            result.push_back(Chunk(b, j->definitions()));
+            result.push_back(Chunk(b, j->sharedDefinitions()));
             ++j;
         } else if (a.addr() < b.addr()) {
-            result.push_back(Chunk(MemoryLocation(a.domain(), a.addr(), b.addr() - a.addr()), i->definitions()));
+            result.push_back(Chunk(MemoryLocation(a.domain(), a.addr(), b.addr() - a.addr()), i->sharedDefinitions()));
         } else if (b.addr() < a.addr()) {
-            result.push_back(Chunk(MemoryLocation(b.domain(), b.addr(), a.addr() - b.addr()), j->definitions()));
+            result.push_back(Chunk(MemoryLocation(b.domain(), b.addr(), a.addr() - b.addr()), j->sharedDefinitions()));
         } else {
-            std::vector<const Term *> merged;
-            merged.reserve(i->definitions().size() + j->definitions().size());
-            std::set_union(i->definitions().begin(), i->definitions().end(), j->definitions().begin(), j->definitions().end(), std::back_inserter(merged));
+            auto merged = unite(i->sharedDefinitions(), j->sharedDefinitions());
 
             if (a.size() < b.size()) {
                 result.push_back(Chunk(a, std::move(merged)));
@@ -27,6 +27,8 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <memory>
 #include <vector>
 
 #include <nc/common/Foreach.h>
@@ -49,10 +51,13 @@ class ReachingDefinitions: public PrintableBase<ReachingDefinitions> {
 public:
     /*
      * Memory location and the list of terms defining this memory location.
+     *
+     * The list of terms is immutable and shared between the copies of the chunk,
+     * so that copying reaching definitions does not copy the lists.
      */
     class Chunk {
         MemoryLocation location_; ///< Memory location.
-        std::vector<const Term *> definitions_; ///< Terms defining this memory location.
+        std::shared_ptr<const std::vector<const Term *>> definitions_; ///< Terms defining this memory location.
 
         public:
 
@@ -63,9 +68,22 @@ public:
          * \param definitions   List of terms defining this memory location.
          */
         Chunk(const MemoryLocation &location, std::vector<const Term *> definitions):
+            location_(location), definitions_(std::make_shared<const std::vector<const Term *>>(std::move(definitions)))
+        {
+            assert(location);
+        }
+
+        /*
+         * Constructor.
+         *
+         * \param location      Valid memory location.
+         * \param definitions   Valid pointer to the shared list of terms defining this memory location.
+         */
+        Chunk(const MemoryLocation &location, std::shared_ptr<const std::vector<const Term *>> definitions):
             location_(location), definitions_(std::move(definitions))
         {
             assert(location);
+            assert(definitions_);
         }
 
         /**
@@ -76,12 +94,12 @@ public:
         /**
          * \return List of terms defining the memory location.
          */
-        std::vector<const Term *> &definitions() { return definitions_; }
+        const std::vector<const Term *> &definitions() const { return *definitions_; }
 
         /**
-         * \return List of terms defining the memory location.
+         * \return Valid pointer to the shared list of terms defining the memory location.
          */
-        const std::vector<const Term *> &definitions() const { return definitions_; }
+        const std::shared_ptr<const std::vector<const Term *>> &sharedDefinitions() const { return definitions_; }
 
         /**
          * \param that Another object of the same type.
@@ -90,7 +108,8 @@ public:
          *         false otherwise.
          */
         bool operator==(const Chunk &that) const {
-            return location_ == that.location_ && definitions_ == that.definitions_;
+            return location_ == that.location_ &&
+                   (definitions_ == that.definitions_ || *definitions_ == *that.definitions_);
         }
     };
 
@@ -197,10 +216,15 @@ public:
     void filterOut(const T &pred) {
         selfTest();
         foreach (auto &chunk, chunks_) {
-            chunk.definitions().erase(
-                std::remove_if(chunk.definitions().begin(), chunk.definitions().end(),
-                    [&](const Term *term) -> bool { return pred(chunk.location(), term); }),
-                chunk.definitions().end());
+            const auto &definitions = chunk.definitions();
+            auto predicate = [&](const Term *term) -> bool { return pred(chunk.location(), term); };
+
+            if (std::any_of(definitions.begin(), definitions.end(), predicate)) {
+                std::vector<const Term *> remainingDefinitions;
+                remainingDefinitions.reserve(definitions.size());
+                std::remove_copy_if(definitions.begin(), definitions.end(), std::back_inserter(remainingDefinitions), predicate);
+                chunk = Chunk(chunk.location(), std::move(remainingDefinitions));
+            }
         }
         chunks_.erase(
             std::remove_if(chunks_.begin(), chunks_.end(),
@@ -13,10 +13,38 @@ namespace ir {
 namespace dflow {
 
 Uses::Uses(const Dataflow &dataflow) {
+    /* Count the uses of each definition, storing the count of term i at i + 1. */
     foreach (auto &termAndDefinitions, dataflow.term2definitions()) {
         foreach (const auto &chunk, termAndDefinitions.second.chunks()) {
             foreach (const Term *definition, chunk.definitions()) {
-                term2uses_[definition].push_back(Use(chunk.location(), termAndDefinitions.first));
+                assert(definition->id() != Term::NO_ID);
+
+                if (definition->id() + 2 > offsets_.size()) {
+                    offsets_.resize(definition->id() + 2);
+                }
+                ++offsets_[definition->id() + 1];
+            }
+        }
+    }
+
+    /* Turn the counts into offsets of the groups. */
+    for (std::size_t i = 1; i < offsets_.size(); ++i) {
+        offsets_[i] += offsets_[i - 1];
+    }
+
+    if (offsets_.empty()) {
+        return;
+    }
+
+    uses_.resize(offsets_.back());
+
+    /* Fill the groups, keeping the position of the next use of each definition. */
+    std::vector<std::size_t> next(offsets_.begin(), offsets_.end() - 1);
+
+    foreach (auto &termAndDefinitions, dataflow.term2definitions()) {
+        foreach (const auto &chunk, termAndDefinitions.second.chunks()) {
+            foreach (const Term *definition, chunk.definitions()) {
+                uses_[next[definition->id()]++] = Use(chunk.location(), termAndDefinitions.first);
             }
         }
     }
@@ -5,11 +5,10 @@
 
 #include <nc/config.h>
 
+#include <cassert>
 #include <vector>
 
-#include <boost/unordered_map.hpp>
-
-#include <nc/common/Range.h>
+#include <boost/range/iterator_range.hpp>
 
 #include <nc/core/ir/Term.h>
 
@@ -25,6 +24,11 @@ class Dataflow;
 
 /**
  * Information about which term is being read by which terms.
+ *
+ * The uses of all write terms are stored in a single array, grouped
+ * by the write term. The groups are found through an array of offsets
+ * indexed by the term's id, so building the information takes two passes
+ * over the dataflow and three allocations, and a lookup takes constant time.
  */
 class Uses {
 public:
@@ -37,6 +41,8 @@ public:
         const Term *term_;
 
     public:
+        Use(): term_(nullptr) {}
+
         Use(const MemoryLocation &location, const Term *term):
             location_(location), term_(term)
         {}
@@ -45,9 +51,20 @@ public:
         const Term *term() const { return term_; }
     };
 
+    /**
+     * Range of uses of a write term.
+     */
+    typedef boost::iterator_range<std::vector<Use>::const_iterator> UseRange;
+
 private:
-    /** Mapping from a write term to the list of its uses. */
-    boost::unordered_map<const Term *, std::vector<Use>> term2uses_;
+    /** Uses of all the write terms, grouped by the write term. */
+    std::vector<Use> uses_;
+
+    /**
+     * Uses of the write term with id i occupy indices from offsets_[i]
+     * up to offsets_[i + 1] in uses_. Terms with larger ids have no uses.
+     */
+    std::vector<std::size_t> offsets_;
 
 public:
     /**
@@ -59,14 +76,21 @@ public:
     Uses(const Dataflow &dataflow);
 
     /**
-     * \param[in] term Valid pointer to a write term.
+     * \param[in] term Valid pointer to a numbered write term of the function
+     *                 whose dataflow the uses were computed from.
      *
-     * \return List of term's uses.
+     * \return Range of term's uses.
      */
-    const std::vector<Use> &getUses(const Term *term) const {
+    UseRange getUses(const Term *term) const {
         assert(term != nullptr);
         assert(term->isWrite());
-        return nc::find(term2uses_, term);
+        assert(term->id() != Term::NO_ID && "The term must be numbered.");
+
+        auto id = term->id();
+        if (id + 1 >= offsets_.size()) {
+            return UseRange(uses_.end(), uses_.end());
+        }
+        return UseRange(uses_.begin() + offsets_[id], uses_.begin() + offsets_[id + 1]);
     }
 };
 
@@ -0,0 +1,32 @@
+/* The file is part of Snowman decompiler. */
+/* See doc/licenses.asciidoc for the licensing information. */
+
+#pragma once
+
+#include <nc/config.h>
+
+#include <memory>
+
+#include <boost/unordered_map.hpp>
+
+#include "Uses.h"
+
+namespace nc {
+namespace core {
+namespace ir {
+
+class Function;
+
+namespace dflow {
+
+/**
+ * Mapping from a function to the use information computed from its dataflow.
+ */
+class UsesMap: public boost::unordered_map<const Function *, std::unique_ptr<const Uses>> {};
+
+} // namespace dflow
+} // namespace ir
+} // namespace core
+} // namespace nc
+
+/* vim:set et sts=4 sw=4: */
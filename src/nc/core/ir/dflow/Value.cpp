@@ -74,6 +74,12 @@ bool bitTwiddlingWorks = (NC_UNUSED(bitTwiddlingWorks), testBitTwiddling());
 } // anonymous namespace
 #endif
 
+Value::Value():
+    isStackOffset_(false), isNotStackOffset_(false), stackOffset_(0),
+    isProduct_(false), isNotProduct_(false),
+    isReturnAddress_(false), isNotReturnAddress_(false)
+{}
+
 Value::Value(SmallBitSize size):
     abstractValue_(size, -1, -1),
     isStackOffset_(false), isNotStackOffset_(false),
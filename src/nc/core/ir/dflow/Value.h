@@ -54,6 +54,11 @@ class Value {
     bool isNotReturnAddress_; ///< Value is not a return address.
 
 public:
+    /**
+     * Constructs a value of zero size, suitable only as a placeholder.
+     */
+    Value();
+
     /**
      * Class constructor.
      *
@@ -143,6 +148,27 @@ public:
      * Marks the value as being not a return address.
      */
     void makeNotReturnAddress() { isNotReturnAddress_ = true; }
+
+    /**
+     * \return True if both values carry exactly the same information.
+     */
+    bool operator==(const Value &that) const {
+        return abstractValue_.size() == that.abstractValue_.size() &&
+               abstractValue_.zeroBits() == that.abstractValue_.zeroBits() &&
+               abstractValue_.oneBits() == that.abstractValue_.oneBits() &&
+               isStackOffset_ == that.isStackOffset_ &&
+               isNotStackOffset_ == that.isNotStackOffset_ &&
+               (!isStackOffset_ || stackOffset_ == that.stackOffset_) &&
+               isProduct_ == that.isProduct_ &&
+               isNotProduct_ == that.isNotProduct_ &&
+               isReturnAddress_ == that.isReturnAddress_ &&
+               isNotReturnAddress_ == that.isNotReturnAddress_;
+    }
+
+    /**
+     * \return True if the values carry different information.
+     */
+    bool operator!=(const Value &that) const { return !(*this == that); }
 };
 
 } // namespace dflow
@@ -38,34 +38,34 @@ namespace types {
 void Type::updateSize(SmallBitSize size) {
     if (size && (!size_ || size < size_)) {
         size_ = size;
-        changed_ = true;
+        ++version_;
     }
 }
 
 void Type::makeInteger() {
     if (!isInteger_) {
         isInteger_ = true;
-        changed_ = true;
+        ++version_;
     }
 }
 
 void Type::makeFloat() {
     if (!isFloat_) {
         isFloat_ = true;
-        changed_ = true;
+        ++version_;
     }
 }
 
 void Type::makePointer(Type *pointee) {
     if (!isPointer_) {
         isPointer_ = true;
-        changed_ = true;
+        ++version_;
     }
 
     if (pointee) {
         if (!pointee_) {
             pointee_ = pointee;
-            changed_ = true;
+            ++version_;
         } else {
             pointee_->unionSet(pointee);
         }
@@ -75,14 +75,14 @@ void Type::makePointer(Type *pointee) {
 void Type::makeSigned() {
     if (!isSigned_) {
         isSigned_ = true;
-        changed_ = true;
+        ++version_;
     }
 }
 
 void Type::makeUnsigned() {
     if (!isUnsigned_) {
         isUnsigned_ = true;
-        changed_ = true;
+        ++version_;
     }
 }
 
@@ -105,7 +105,7 @@ void Type::updateFactor(ConstantValue increment) {
     factor_ = gcd(increment, factor_);
 
     if (oldFactor != factor_) {
-        changed_ = true;
+        ++version_;
     }
 }
 
@@ -120,15 +120,6 @@ void Type::addOffset(ByteSize offset, Type *typeTraits) {
 }
 #endif
 
-bool Type::changed() {
-    if (changed_) {
-        changed_ = false;
-        return true;
-    } else {
-        return false;
-    }
-}
-
 void Type::unionSet(Type *that) {
     Type *thisSet = this->findSet();
     Type *thatSet = that->findSet();
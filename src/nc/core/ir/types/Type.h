@@ -61,7 +61,7 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
     std::map<ByteSize, Type *> offsets_; ///< Type traits of byte offsets to values of this type.
 #endif
 
-    bool changed_; ///< Type properties have changed since last call to changed().
+    std::size_t version_; ///< Number of changes of type properties.
 
     public:
 
@@ -71,7 +71,7 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
     Type():
         size_(0),
         isInteger_(false), isFloat_(false), isPointer_(false), pointee_(0),
-        isSigned_(false), isUnsigned_(false), factor_(0), changed_(false)
+        isSigned_(false), isUnsigned_(false), factor_(0), version_(0)
     { 
 #ifdef NC_STRUCT_RECOVERY
         addOffset(0, this); 
@@ -180,9 +180,10 @@ class Type: public DisjointSet<Type>, public PrintableBase<Type> {
 #endif
 
     /**
-     * \return True, if type properties have changed since last call to this function.
+     * \return Number of changes of type properties. Use it to find out
+     *         whether the type has changed since the last time you looked.
      */
-    bool changed();
+    std::size_t version() const { return version_; }
 
     /**
      * Merges this and that types together.
@@ -24,8 +24,13 @@
 
 #include "TypeAnalyzer.h"
 
+#include <deque>
+
+#include <boost/unordered_map.hpp>
+
 #include <nc/common/CancellationToken.h>
 #include <nc/common/Foreach.h>
+#include <nc/common/Range.h>
 
 #include <nc/core/ir/BasicBlock.h>
 #include <nc/core/ir/Function.h>
@@ -58,21 +63,16 @@ void TypeAnalyzer::analyze() {
     uniteArgumentTypes();
     markStackPointersAsPointers();
 
-    /*
-     * Recompute types until reaching fixpoint.
-     */
-    bool changed;
-    do {
-        changed = false;
-
-        foreach (const Function *function, functions_.list()) {
-            while (analyze(function)) {
-                changed = true;
-                canceled_.poll();
-            }
-            canceled_.poll();
+    /* Types are not reconstructed in functions exceeding their budget. */
+    std::vector<const Term *> terms;
+    foreach (const Function *function, functions_.list()) {
+        if (!function->isDegraded()) {
+            const auto &liveTerms = livenesses_.at(function)->liveTerms();
+            terms.insert(terms.end(), liveTerms.begin(), liveTerms.end());
         }
-    } while (changed);
+    }
+
+    analyze(terms);
 }
 
 void TypeAnalyzer::uniteTypesOfAssignedTerms() {
@@ -162,27 +162,165 @@ void TypeAnalyzer::markStackPointersAsPointers() {
     }
 }
 
-bool TypeAnalyzer::analyze(const Function *function) {
-    const auto &liveness = *livenesses_.at(function);
+namespace {
+
+/**
+ * Calls the given function for the term and for each of its operands:
+ * these are all the terms whose types are read by TypeAnalyzer::analyze(term).
+ */
+template<class F>
+void forEachInvolvedTerm(const Term *term, F fun) {
+    fun(term);
 
+    switch (term->kind()) {
+        case Term::DEREFERENCE:
+            fun(term->asDereference()->address());
+            break;
+        case Term::UNARY_OPERATOR:
+            fun(term->asUnaryOperator()->operand());
+            break;
+        case Term::BINARY_OPERATOR:
+            fun(term->asBinaryOperator()->left());
+            fun(term->asBinaryOperator()->right());
+            break;
+        default:
+            break;
+    }
+}
+
+} // anonymous namespace
+
+void TypeAnalyzer::analyze(const std::vector<const Term *> &terms) {
     /*
-     * Going in both directions makes the process
-     * converge much faster on some examples.
+     * Types are shared between terms via unions, possibly across functions.
+     * Therefore, the analyzer keeps track of the classes of types: for each
+     * representative, the version of it last seen and the terms in the class.
+     * When a class changes or gets united into another one, the terms
+     * reading the types of the class' members are put to the worklist.
      */
-    foreach (const Term *term, liveness.liveTerms()) {
-        analyze(term);
+    struct TypeClass {
+        std::size_t version;
+        std::vector<std::size_t> members;
+    };
+
+    std::vector<const Term *> trackedTerms;
+    boost::unordered_map<const Term *, std::size_t> term2index;
+
+    auto getIndex = [&](const Term *term) -> std::size_t {
+        auto i = term2index.find(term);
+        if (i != term2index.end()) {
+            return i->second;
+        }
+        std::size_t index = trackedTerms.size();
+        term2index.emplace(term, index);
+        trackedTerms.push_back(term);
+        return index;
+    };
+
+    /* readers[i] are the indices in terms of the terms reading the type of trackedTerms[i]. */
+    std::vector<std::vector<std::size_t>> readers;
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+        forEachInvolvedTerm(terms[i], [&](const Term *term) {
+            std::size_t index = getIndex(term);
+            if (index >= readers.size()) {
+                readers.resize(index + 1);
+            }
+            readers[index].push_back(i);
+        });
+    }
+
+    boost::unordered_map<Type *, TypeClass> classes;
+    std::vector<Type *> recordedClasses(trackedTerms.size());
+
+    for (std::size_t i = 0; i < trackedTerms.size(); ++i) {
+        Type *type = types_.getType(trackedTerms[i]);
+        auto &typeClass = classes[type];
+        typeClass.version = type->version();
+        typeClass.members.push_back(i);
+        recordedClasses[i] = type;
     }
-    reverse_foreach (const Term *term, liveness.liveTerms()) {
-        analyze(term);
+
+    /* Initially, every term is in the worklist. */
+    std::deque<std::size_t> worklist;
+    std::vector<bool> queued(terms.size(), true);
+    for (std::size_t i = 0; i < terms.size(); ++i) {
+        worklist.push_back(i);
     }
 
-    bool changed = false;
-    foreach (const Term *term, liveness.liveTerms()) {
-        if (types_.getType(term)->changed()) {
-            changed = true;
+    auto enqueueReaders = [&](const TypeClass &typeClass) {
+        foreach (std::size_t member, typeClass.members) {
+            foreach (std::size_t reader, readers[member]) {
+                if (!queued[reader]) {
+                    queued[reader] = true;
+                    worklist.push_back(reader);
+                }
+            }
+        }
+    };
+
+    auto refresh = [&](Type *recorded) {
+        auto i = classes.find(recorded);
+        if (i == classes.end()) {
+            return;
+        }
+
+        Type *representative = recorded->findSet();
+        if (representative != recorded) {
+            enqueueReaders(i->second);
+
+            auto members = std::move(i->second.members);
+            classes.erase(i);
+
+            auto j = classes.find(representative);
+            if (j == classes.end()) {
+                j = classes.emplace(representative, TypeClass{representative->version(), {}}).first;
+            }
+            foreach (std::size_t member, members) {
+                recordedClasses[member] = representative;
+            }
+            j->second.members.insert(j->second.members.end(), members.begin(), members.end());
+
+            i = j;
+        }
+
+        if (i->second.version != representative->version()) {
+            i->second.version = representative->version();
+            enqueueReaders(i->second);
+        }
+    };
+
+    while (true) {
+        while (!worklist.empty()) {
+            std::size_t index = worklist.front();
+            worklist.pop_front();
+            queued[index] = false;
+
+            analyze(terms[index]);
+
+            forEachInvolvedTerm(terms[index], [&](const Term *term) {
+                refresh(recordedClasses[nc::find(term2index, term)]);
+            });
+
+            canceled_.poll();
+        }
+
+        /*
+         * Uniting pointees changes classes not involved in the term
+         * being recomputed. Catch up on these changes.
+         */
+        std::vector<Type *> recorded;
+        recorded.reserve(classes.size());
+        foreach (const auto &typeAndClass, classes) {
+            recorded.push_back(typeAndClass.first);
+        }
+        foreach (Type *type, recorded) {
+            refresh(type);
+        }
+
+        if (worklist.empty()) {
+            break;
         }
     }
-    return changed;
 }
 
 void TypeAnalyzer::analyze(const Term *term) {
@@ -25,6 +25,8 @@
 
 #include <nc/config.h>
 
+#include <vector>
+
 namespace nc {
 
 class CancellationToken;
@@ -122,13 +124,13 @@ private:
     void markStackPointersAsPointers();
 
     /**
-     * Recomputes types of terms in the given function.
-     *
-     * \param function Valid pointer to a function.
+     * Recomputes types of the given terms until reaching fixpoint.
+     * After the first visit, a term is recomputed only when the type
+     * of the term or of one of its operands changes.
      *
-     * \return True if types changed, false otherwise.
+     * \param terms Valid pointers to the terms.
      */
-    bool analyze(const Function *function);
+    void analyze(const std::vector<const Term *> &terms);
 
     /**
      * Recomputes type of the given term.
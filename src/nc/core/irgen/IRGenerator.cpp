@@ -41,6 +41,7 @@
 #include <nc/core/image/Reader.h>
 #include <nc/core/image/Section.h>
 #include <nc/core/ir/Jump.h>
+#include <nc/core/ir/Numbering.h>
 #include <nc/core/ir/Program.h>
 #include <nc/core/ir/Statements.h>
 #include <nc/core/ir/dflow/Dataflow.h>
@@ -110,7 +111,17 @@ void IRGenerator::generate() {
 void IRGenerator::computeJumpTargets(ir::BasicBlock *basicBlock) {
     assert(basicBlock != nullptr);
 
-    /* Prepare context for quick and dirty dataflow analysis. */
+    /*
+     * Prepare context for quick and dirty dataflow analysis.
+     * Statements may keep ids from an analysis of the block
+     * they were split from, so they are renumbered from scratch.
+     */
+    ir::Numbering numbering;
+    foreach (auto statement, basicBlock->statements()) {
+        ir::Numbering::clearIds(statement);
+        numbering.assignIds(statement);
+    }
+
     ir::dflow::Dataflow dataflow;
     ir::dflow::DataflowAnalyzer analyzer(dataflow, image_->platform().architecture(), canceled_, log_);
     ir::dflow::ReachingDefinitions definitions;
@@ -206,20 +217,34 @@ std::vector<ByteAddr> IRGenerator::getJumpTableEntries(const ir::Term *target, c
     auto byteOrder = image_->platform().architecture()->getByteOrder(ir::MemoryDomain::MEMORY);
 
     ByteAddr address = arrayAccess.base();
-    while (auto entry = reader.readInt<ByteAddr>(address, entrySize, byteOrder)) {
-        if (!isInstructionAddress(*entry)) {
-            break;
+
+    if (entrySize <= 0 || static_cast<ByteSize>(arrayAccess.stride()) <= 0) {
+        return result;
+    }
+
+    /* The table ends at the first entry which is not an instruction address. Read it in batches. */
+    const std::size_t batchSize = 64;
+
+    while (true) {
+        auto entries = reader.readArray<ByteAddr>(address, entrySize, batchSize, byteOrder, arrayAccess.stride());
+
+        foreach (ByteAddr entry, entries) {
+            if (!isInstructionAddress(entry)) {
+                return result;
+            }
+            result.push_back(entry);
+            address += arrayAccess.stride();
+
+            if (result.size() > maxTableEntries) {
+                log_.warning(tr("Jump table at address %1 seems to have more than %2 entries.").arg(address).arg(maxTableEntries));
+                return result;
+            }
         }
-        result.push_back(*entry);
-        address += arrayAccess.stride();
 
-        if (result.size() > maxTableEntries) {
-            log_.warning(tr("Jump table at address %1 seems to have more than %2 entries.").arg(address).arg(maxTableEntries));
-            break;
+        if (entries.size() < batchSize) {
+            return result;
         }
     }
-
-    return result;
 }
 
 bool IRGenerator::isInstructionAddress(ByteAddr address) {
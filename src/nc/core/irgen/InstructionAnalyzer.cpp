@@ -48,9 +48,9 @@ void InstructionAnalyzer::createStatements(const arch::Instructions *instruction
 
 void InstructionAnalyzer::doCreateStatements(const arch::Instructions *instructions, ir::Program *program,
                       const CancellationToken &canceled, const LogToken &log) {
-    foreach (const auto &instr, instructions->all()) {
+    foreach (auto instr, instructions->all()) {
         try {
-            createStatements(instr.get(), program);
+            createStatements(instr, program);
         } catch (const InvalidInstructionException &e) {
             /* Note: this is an AntiIdiom: http://c2.com/cgi/wiki?LoggingDiscussion */
             log.warning(e.unicodeWhat());
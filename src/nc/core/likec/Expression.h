@@ -26,6 +26,7 @@
 #include <nc/config.h>
 
 #include <cassert>
+#include <cstddef>
 
 #include "TreeNode.h"
 
@@ -38,6 +39,8 @@ namespace ir {
 
 namespace likec {
 
+class Type;
+
 /**
  * Base class for different kinds of expressions.
  */
@@ -45,6 +48,8 @@ class Expression: public TreeNode {
     NC_BASE_CLASS(Expression, expressionKind)
 
     const ir::Term *term_; ///< Term this expression was created from.
+    mutable const Type *cachedType_; ///< Type of the expression computed by a type calculator.
+    mutable std::size_t cachedTypeStamp_; ///< Stamp of the type calculator that computed cachedType_.
 
 public:
     enum {
@@ -67,7 +72,7 @@ public:
      * \param[in] expressionKind Kind of expression.
      */
     explicit Expression(int expressionKind):
-        TreeNode(EXPRESSION), expressionKind_(expressionKind), term_(nullptr)
+        TreeNode(EXPRESSION), expressionKind_(expressionKind), term_(nullptr), cachedType_(nullptr), cachedTypeStamp_(0)
     {}
 
     /**
@@ -84,6 +89,24 @@ public:
 
         term_ = term;
     }
+
+    /**
+     * \param[in] stamp Stamp of a type calculator.
+     *
+     * \return Type of the expression cached by the type calculator with this stamp. Can be nullptr.
+     */
+    const Type *getCachedType(std::size_t stamp) const { return cachedTypeStamp_ == stamp ? cachedType_ : nullptr; }
+
+    /**
+     * Caches the type of the expression.
+     *
+     * \param[in] stamp Stamp of the type calculator that computed the type, or 0 to drop the cached type.
+     * \param[in] type Type of the expression. Can be nullptr.
+     */
+    void setCachedType(std::size_t stamp, const Type *type) const {
+        cachedTypeStamp_ = stamp;
+        cachedType_ = type;
+    }
 };
 
 } // namespace likec
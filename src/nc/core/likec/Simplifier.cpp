@@ -125,6 +125,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<Expression> nod
 std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator> node) {
     node->left() = simplify(std::move(node->left()));
     node->right() = simplify(std::move(node->right()));
+    typeCalculator_.invalidate(node.get());
 
     /* Remove typecasts of operands if this won't change anything. */
     switch (node->operatorKind()) {
@@ -140,6 +141,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator>
                             typeCalculator_.getBinaryOperatorType(node->operatorKind(), typecast->operand().get(),
                                                                   right.get())) {
                             left = std::move(typecast->operand());
+                            typeCalculator_.invalidate(node.get());
                         }
                     }
                 }
@@ -303,6 +305,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator>
         case BinaryOperator::LOGICAL_AND: {
             node->left() = simplifyBooleanExpression(std::move(node->left()));
             node->right() = simplifyBooleanExpression(std::move(node->right()));
+            typeCalculator_.invalidate(node.get());
             break;
         }
     }
@@ -316,12 +319,14 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator>
             if (auto constant = node->left()->as<IntegerConstant>()) {
                 if (constant->type()->isSigned() && constant->value().size() > 1 && constant->value().signedValue() < 0) {
                     node->setOperatorKind(BinaryOperator::SUB);
+                    typeCalculator_.invalidate(node.get());
                     constant->setValue(SizedValue(constant->value().size(), constant->value().absoluteValue()));
                 }
             }
             if (auto constant = node->right()->as<IntegerConstant>()) {
                 if (constant->type()->isSigned() && constant->value().size() > 1 && constant->value().signedValue() < 0) {
                     node->setOperatorKind(BinaryOperator::SUB);
+                    typeCalculator_.invalidate(node.get());
                     constant->setValue(SizedValue(constant->value().size(), constant->value().absoluteValue()));
                 }
             }
@@ -331,6 +336,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator>
             if (auto constant = node->right()->as<IntegerConstant>()) {
                 if (constant->type()->isSigned() && constant->value().size() > 1 && constant->value().signedValue() < 0) {
                     node->setOperatorKind(BinaryOperator::ADD);
+                    typeCalculator_.invalidate(node.get());
                     constant->setValue(SizedValue(constant->value().size(), constant->value().absoluteValue()));
                 }
             }
@@ -406,6 +412,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<BinaryOperator>
 std::unique_ptr<CallOperator> Simplifier::simplify(std::unique_ptr<CallOperator> node) {
     node->callee() = simplify(std::move(node->callee()));
     node->arguments() = simplify(std::move(node->arguments()));
+    typeCalculator_.invalidate(node.get());
     return node;
 }
 
@@ -434,6 +441,7 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<Typecast> node)
                         Typecast::REINTERPRET_CAST,
                         typeCalculator_.tree().makePointerType(innerCast->type()->size(), node->type()),
                         std::move(innerCast->operand()));
+                    typeCalculator_.invalidate(deref);
                     return simplify(std::move(node->operand()));
                 }
             }
@@ -480,10 +488,12 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<Typecast> node)
 
 std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<UnaryOperator> node) {
     node->operand() = simplify(std::move(node->operand()));
+    typeCalculator_.invalidate(node.get());
 
     if (node->operatorKind() == UnaryOperator::BITWISE_NOT &&
         typeCalculator_.getType(node->operand().get())->size() == 1) {
         node->setOperatorKind(UnaryOperator::LOGICAL_NOT);
+        typeCalculator_.invalidate(node.get());
     }
 
     switch (node->operatorKind()) {
@@ -508,26 +518,33 @@ std::unique_ptr<Expression> Simplifier::simplify(std::unique_ptr<UnaryOperator>
         }
         case UnaryOperator::LOGICAL_NOT: {
             node->operand() = simplifyBooleanExpression(std::move(node->operand()));
+            typeCalculator_.invalidate(node.get());
 
             if (auto binary = node->operand()->as<BinaryOperator>()) {
                 switch (binary->operatorKind()) {
                     case BinaryOperator::EQ:
                         binary->setOperatorKind(BinaryOperator::NEQ);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     case BinaryOperator::NEQ:
                         binary->setOperatorKind(BinaryOperator::EQ);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     case BinaryOperator::LT:
                         binary->setOperatorKind(BinaryOperator::GEQ);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     case BinaryOperator::LEQ:
                         binary->setOperatorKind(BinaryOperator::GT);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     case BinaryOperator::GT:
                         binary->setOperatorKind(BinaryOperator::LEQ);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     case BinaryOperator::GEQ:
                         binary->setOperatorKind(BinaryOperator::LT);
+                        typeCalculator_.invalidate(binary);
                         return std::move(node->operand());
                     default:
                         break;
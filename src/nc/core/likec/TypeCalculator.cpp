@@ -1,5 +1,8 @@
 #include "TypeCalculator.h"
 
+#include <atomic>
+#include <cassert>
+
 #include <nc/common/Unreachable.h>
 
 #include "BinaryOperator.h"
@@ -23,6 +26,26 @@ namespace nc {
 namespace core {
 namespace likec {
 
+namespace {
+
+std::atomic<std::size_t> lastStamp(0);
+
+} // anonymous namespace
+
+TypeCalculator::TypeCalculator(Tree &tree):
+    tree_(tree), stamp_(++lastStamp)
+{}
+
+void TypeCalculator::invalidate(const Expression *node) {
+    assert(node != nullptr);
+    node->setCachedType(0, nullptr);
+}
+
+const Type *TypeCalculator::cacheType(const Expression *node, const Type *type) {
+    node->setCachedType(stamp_, type);
+    return type;
+}
+
 const Type *TypeCalculator::getType(const Expression *node) {
     switch (node->expressionKind()) {
         case Expression::BINARY_OPERATOR:
@@ -52,14 +75,20 @@ const Type *TypeCalculator::getType(const Expression *node) {
 }
 
 const Type *TypeCalculator::getType(const BinaryOperator *node) {
-    return getBinaryOperatorType(node->operatorKind(), node->left(), node->right());
+    if (auto type = node->getCachedType(stamp_)) {
+        return type;
+    }
+    return cacheType(node, getBinaryOperatorType(node->operatorKind(), node->left(), node->right()));
 }
 
 const Type *TypeCalculator::getType(const CallOperator *node) {
+    if (auto type = node->getCachedType(stamp_)) {
+        return type;
+    }
     if (auto functionPointerType = getType(node->callee())->as<FunctionPointerType>()) {
-        return functionPointerType->returnType();
+        return cacheType(node, functionPointerType->returnType());
     } else {
-        return tree_.makeErroneousType();
+        return cacheType(node, tree_.makeErroneousType());
     }
 }
 
@@ -88,6 +117,13 @@ const Type *TypeCalculator::getType(const Typecast *node) {
 }
 
 const Type *TypeCalculator::getType(const UnaryOperator *node) {
+    if (auto type = node->getCachedType(stamp_)) {
+        return type;
+    }
+    return cacheType(node, computeType(node));
+}
+
+const Type *TypeCalculator::computeType(const UnaryOperator *node) {
     auto operandType = getType(node->operand());
 
     switch (node->operatorKind()) {
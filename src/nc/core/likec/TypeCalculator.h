@@ -5,7 +5,7 @@
 
 #include <nc/config.h>
 
-#include <boost/unordered_map.hpp>
+#include <cstddef>
 
 namespace nc {
 namespace core {
@@ -26,11 +26,28 @@ class UnaryOperator;
 class UndeclaredIdentifier;
 class VariableIdentifier;
 
+/**
+ * Calculator of types of expressions.
+ *
+ * Types of operators are cached on the expression nodes, so that computing
+ * the type of each node of a tree bottom-up takes linear time. A cached type
+ * is only seen by the calculator that computed it. Code rewriting an operator
+ * in place must call invalidate() on it.
+ */
 class TypeCalculator {
     Tree &tree_;
+    std::size_t stamp_; ///< Stamp identifying the types cached by this calculator.
 
 public:
-    explicit TypeCalculator(Tree &tree): tree_(tree) {}
+    explicit TypeCalculator(Tree &tree);
+
+    /**
+     * Drops the cached type of an expression node.
+     * Must be called after changing the node's operator kind or operands.
+     *
+     * \param node Valid pointer to the expression.
+     */
+    void invalidate(const Expression *node);
 
     const Type *getType(const Expression *node);
     const Type *getType(const BinaryOperator *node);
@@ -46,6 +63,10 @@ public:
     const Type *getType(const UndeclaredIdentifier *node);
     const Type *getBinaryOperatorType(int operatorKind, const Expression *left, const Expression *right);
     Tree &tree() { return tree_; }
+
+private:
+    const Type *computeType(const UnaryOperator *node);
+    const Type *cacheType(const Expression *node, const Type *type);
 };
 
 } // namespace likec
@@ -32,17 +32,19 @@
 namespace nc {
 namespace gui {
 
-Decompilation::Decompilation(const std::shared_ptr<core::Context> &context):
-    context_(context)
+Decompilation::Decompilation(const std::shared_ptr<core::Context> &context, const std::shared_ptr<core::Context> &previous):
+    context_(context),
+    previous_(previous)
 {
     assert(context);
+    assert(previous);
 }
 
 Decompilation::~Decompilation() {}
 
 void Decompilation::work() {
     try {
-        core::Driver::decompile(*context_);
+        core::Driver::decompile(*context_, *previous_);
     } catch (const CancellationException &) {
         /* Nothing to do. */
     }
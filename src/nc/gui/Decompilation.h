@@ -46,14 +46,19 @@ class Decompilation: public Activity {
     /** Context. */
     std::shared_ptr<core::Context> context_;
 
+    /** Context of the previous decompilation. */
+    std::shared_ptr<core::Context> previous_;
+
     public:
 
     /**
      * Constructor.
      *
      * \param context Valid pointer to the context.
+     * \param previous Valid pointer to the context of the previous decompilation,
+     *                 whose analysis results are reused.
      */
-    explicit Decompilation(const std::shared_ptr<core::Context> &context);
+    Decompilation(const std::shared_ptr<core::Context> &context, const std::shared_ptr<core::Context> &previous);
 
     /**
      * Destructor.
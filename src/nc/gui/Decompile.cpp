@@ -53,9 +53,9 @@ void Decompile::work() {
     context->setCancellationToken(cancellationToken());
     context->setLogToken(project_->logToken());
 
-    project_->setContext(context);
+    auto previous = project_->setDecompilationContext(context);
 
-    delegate(std::make_unique<Decompilation>(context));
+    delegate(std::make_unique<Decompilation>(context, previous));
 }
 
 }} // namespace nc::gui
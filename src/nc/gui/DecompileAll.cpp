@@ -52,9 +52,9 @@ void DecompileAll::work() {
     context->setCancellationToken(cancellationToken());
     context->setLogToken(project_->logToken());
 
-    project_->setContext(context);
+    auto previous = project_->setDecompilationContext(context);
 
-    delegate(std::make_unique<Decompilation>(context));
+    delegate(std::make_unique<Decompilation>(context, previous));
 }
 
 }} // namespace nc::gui
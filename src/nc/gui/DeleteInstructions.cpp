@@ -25,6 +25,7 @@
 #include "DeleteInstructions.h"
 
 #include <nc/common/Foreach.h>
+#include <nc/common/Range.h>
 
 #include <nc/core/arch/Instructions.h>
 
@@ -38,12 +39,11 @@ DeleteInstructions::DeleteInstructions(Project *project, const std::vector<const
 {
     assert(project);
 
-    instructions_.reserve(instructions.size());
+    snapshot_ = project->instructions();
 
     foreach (const core::arch::Instruction *instruction, instructions) {
-        auto instr = project->instructions()->get(instruction->addr());
-        if (instr.get() == instruction) {
-            instructions_.push_back(instr);
+        if (snapshot_->get(instruction->addr()) == instruction) {
+            instructions_.insert(instruction);
         }
     }
 }
@@ -52,9 +52,9 @@ void DeleteInstructions::work() {
     project_->logToken().info(tr("Deleting %1 instruction(s)...", nullptr, static_cast<int>(instructions_.size())).arg(instructions_.size()));
 
     auto newInstructions = std::make_shared<core::arch::Instructions>(*project_->instructions());
-    foreach (const auto &instruction, instructions_) {
-        newInstructions->remove(instruction.get());
-    }
+    newInstructions->removeIf([this](const core::arch::Instruction *instruction) {
+        return nc::contains(instructions_, instruction);
+    });
 
     project_->setInstructions(newInstructions);
 
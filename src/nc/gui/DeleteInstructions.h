@@ -28,6 +28,8 @@
 #include <memory>
 #include <vector>
 
+#include <boost/unordered_set.hpp>
+
 #include "Command.h"
 
 namespace nc {
@@ -35,6 +37,7 @@ namespace nc {
 namespace core {
     namespace arch {
         class Instruction;
+        class Instructions;
     }
 }
 
@@ -51,8 +54,11 @@ class DeleteInstructions: public Command {
     /** Project. */
     Project *project_;
 
+    /** Instructions of the project at the moment of the command's creation. Keeps the instructions to be removed alive. */
+    std::shared_ptr<const core::arch::Instructions> snapshot_;
+
     /** Instructions to be removed. */
-    std::vector<std::shared_ptr<const core::arch::Instruction>> instructions_;
+    boost::unordered_set<const core::arch::Instruction *> instructions_;
 
     public:
 
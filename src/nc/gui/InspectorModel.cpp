@@ -163,10 +163,22 @@ void expand(InspectorItem *item, const core::ir::Term *term, const core::Context
     }
     item->addChild(tr("size = %1").arg(term->size()));
 
-    if (term->statement() && term->statement()->basicBlock() && term->statement()->basicBlock()->function()) {
-        auto &dataflow = *context->dataflows()->at(term->statement()->basicBlock()->function());
+    const core::ir::Function *function = nullptr;
+    if (term->statement() && term->statement()->basicBlock()) {
+        function = term->statement()->basicBlock()->function();
+    }
+
+    /* The dataflow is missing while an incremental decompilation has taken it over. */
+    const core::ir::dflow::Dataflow *dataflow = nullptr;
+    if (function) {
+        auto i = context->dataflows()->find(function);
+        if (i != context->dataflows()->end()) {
+            dataflow = i->second.get();
+        }
+    }
 
-        if (const core::ir::dflow::Value *value = dataflow.getValue(term)) {
+    if (dataflow) {
+        if (const core::ir::dflow::Value *value = dataflow->getValue(term)) {
             InspectorItem *valueItem = item->addChild(tr("value properties"));
             if (value->abstractValue().isConcrete()) {
                 valueItem->addChild(tr("constant value = %1").arg(value->abstractValue().asConcrete().value()));
@@ -194,20 +206,22 @@ void expand(InspectorItem *item, const core::ir::Term *term, const core::Context
             }
         }
 
-        if (auto &memoryLocation = dataflow.getMemoryLocation(term)) {
+        if (auto &memoryLocation = dataflow->getMemoryLocation(term)) {
             item->addChild(tr("computed memory location = %1").arg(memoryLocation.toString()));
         }
 
         if (term->isRead()) {
             InspectorItem *definitionsItem = item->addChild(tr("definitions"));
 
-            foreach (auto &chunk, dataflow.getDefinitions(term).chunks()) {
+            foreach (auto &chunk, dataflow->getDefinitions(term).chunks()) {
                 auto chunkItem = definitionsItem->addChild(chunk.location().toString());
                 foreach (auto definition, chunk.definitions()) {
                     chunkItem->addChild("", definition);
                 }
             }
         }
+    } else if (function) {
+        item->addChild("dataflow = nullptr");
     } else {
         item->addChild("function = nullptr");
     }
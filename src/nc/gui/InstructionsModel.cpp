@@ -54,8 +54,8 @@ InstructionsModel::InstructionsModel(QObject *parent, std::shared_ptr<const core
     if (instructions_) {
         instructionsVector_.reserve(instructions_->size());
 
-        foreach (const auto &instruction, instructions_->all()) {
-            instructionsVector_.push_back(instruction.get());
+        foreach (auto instruction, instructions_->all()) {
+            instructionsVector_.push_back(instruction);
         }
     }
 }
@@ -673,7 +673,7 @@ bool MainWindow::jumpToAddress(ByteAddr address) {
     }
 
     if (auto instruction = project()->instructions()->getCovering(address)) {
-        instructionsView_->highlightInstructions(std::vector<const core::arch::Instruction *>(1, instruction.get()));
+        instructionsView_->highlightInstructions(std::vector<const core::arch::Instruction *>(1, instruction));
         return true;
     } else {
         setStatusText(tr("There is no instruction at address %1.").arg(address, 0, 16));
@@ -24,10 +24,14 @@
 
 #include "Project.h"
 
+#include <algorithm>
 #include <cassert>
 
+#include <boost/unordered_set.hpp>
+
 #include <nc/common/make_unique.h>
 #include <nc/common/Foreach.h>
+#include <nc/common/Range.h>
 
 #include <nc/core/Context.h>
 #include <nc/core/arch/Instructions.h>
@@ -95,6 +99,31 @@ void Project::setContext(const std::shared_ptr<const core::Context> &context) {
     }
 }
 
+std::shared_ptr<core::Context> Project::setDecompilationContext(const std::shared_ptr<core::Context> &context) {
+    assert(context);
+
+    pendingContexts_.push_back(context);
+    connect(context.get(), SIGNAL(treeChanged()), this, SLOT(commitDecompilationContext()));
+
+    return decompilationContext_ ? decompilationContext_ : std::make_shared<core::Context>();
+}
+
+void Project::commitDecompilationContext() {
+    auto i = std::find_if(pendingContexts_.begin(), pendingContexts_.end(),
+        [this](const std::shared_ptr<core::Context> &context) { return context.get() == sender(); });
+
+    if (i == pendingContexts_.end()) {
+        return;
+    }
+
+    decompilationContext_ = *i;
+    setContext(decompilationContext_);
+    Q_EMIT treeChanged();
+
+    /* The views do not show the contexts the canceled decompilations took functions from anymore. */
+    pendingContexts_.erase(pendingContexts_.begin(), i + 1);
+}
+
 void Project::deleteInstructions(const std::vector<const core::arch::Instruction *> &instructions) {
     commandQueue()->push(std::make_unique<DeleteInstructions>(this, instructions));
 }
@@ -118,14 +147,12 @@ void Project::decompile() {
 }
 
 void Project::decompile(const std::vector<const core::arch::Instruction *> &instructions) {
-    auto subset = std::make_shared<core::arch::Instructions>();
+    boost::unordered_set<const core::arch::Instruction *> selected(instructions.begin(), instructions.end());
 
-    foreach (const core::arch::Instruction *instruction, instructions) {
-        auto instr = this->instructions()->get(instruction->addr());
-        if (instr.get() == instruction) {
-            subset->add(instr);
-        }
-    }
+    auto subset = std::make_shared<core::arch::Instructions>(*this->instructions());
+    subset->removeIf([&](const core::arch::Instruction *instruction) {
+        return !nc::contains(selected, instruction);
+    });
 
     decompile(subset);
 }
@@ -73,6 +73,16 @@ class Project: public QObject {
     /** Current context. */
     std::shared_ptr<const core::Context> context_;
 
+    /** Context of the last successful decompilation. */
+    std::shared_ptr<core::Context> decompilationContext_;
+
+    /**
+     * Contexts of the decompilations started after the last successful one.
+     * Canceled ones are kept, as they own the functions taken over from
+     * the context of the last successful decompilation.
+     */
+    std::vector<std::shared_ptr<core::Context>> pendingContexts_;
+
     /** Log token. */
     LogToken logToken_;
 
@@ -141,6 +151,17 @@ class Project: public QObject {
      */
     void setContext(const std::shared_ptr<const core::Context> &context);
 
+    /**
+     * Registers the context of a new decompilation. The current context
+     * stays in place until the new decompilation succeeds, i.e. until the tree
+     * of the new context is computed. Then the new context becomes current.
+     *
+     * \param context Valid pointer to the new context.
+     *
+     * \return Valid pointer to the context of the last successful decompilation.
+     */
+    std::shared_ptr<core::Context> setDecompilationContext(const std::shared_ptr<core::Context> &context);
+
     /**
      * Sets the log token.
      *
@@ -233,6 +254,11 @@ class Project: public QObject {
      * Takes and sets the set of instructions from context.
      */
     void updateInstructions();
+
+    /**
+     * Makes the context of the decompilation that has just succeeded current.
+     */
+    void commitDecompilationContext();
 };
 
 }} // namespace nc::gui
@@ -49,6 +49,7 @@ namespace elf {
 namespace {
 
 using nc::core::input::read;
+using nc::core::input::readBytes;
 using nc::core::input::ParseError;
 
 class Elf32 {
@@ -111,6 +112,7 @@ class ElfParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    const core::image::MappedFile *mappedFile_;
 
     typename Elf::Ehdr ehdr_;
     ByteOrder byteOrder_;
@@ -120,8 +122,9 @@ class ElfParserImpl {
     boost::unordered_map<std::size_t, std::vector<std::unique_ptr<core::image::Relocation>>> relocationTables_;
 
 public:
-    ElfParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log):
-        source_(source), image_(image), log_(log), byteOrder_(ByteOrder::Current)
+    ElfParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log,
+                  const core::image::MappedFile *mappedFile):
+        source_(source), image_(image), log_(log), mappedFile_(mappedFile), byteOrder_(ByteOrder::Current)
     {}
 
     void parse() {
@@ -239,8 +242,8 @@ private:
             section->setData(section->isAllocated() && !section->isCode() && !section->isBss());
 
             if (!section->isBss()) {
-                if (source_->seek(shdr.sh_offset)) {
-                    auto bytes = source_->read(shdr.sh_size);
+                if (auto content = readBytes(source_, mappedFile_, shdr.sh_offset, shdr.sh_size)) {
+                    auto &bytes = *content;
 
                     if (bytes.size() != static_cast<int>(shdr.sh_size)) {
                         log_.warning(tr("Could read only 0x%1 bytes of section %2, although its size is 0x%3.")
@@ -306,8 +309,8 @@ private:
                 section->setBss(false);
                 section->setData(!section->isExecutable());
 
-                if (source_->seek(phdr.p_offset)) {
-                    auto bytes = source_->read(phdr.p_filesz);
+                if (auto content = readBytes(source_, mappedFile_, phdr.p_offset, phdr.p_filesz)) {
+                    auto &bytes = *content;
 
                     if (bytes.size() != static_cast<int>(phdr.p_filesz)) {
                         log_.warning(tr("Could read only 0x%1 bytes of segment %2, although its size is 0x%3.")
@@ -454,7 +457,8 @@ bool ElfParser::doCanParse(QIODevice *source) const {
     return read(source, ehdr) && IS_ELF(ehdr);
 }
 
-void ElfParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log) const {
+void ElfParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log,
+                        const core::image::MappedFile *mappedFile) const {
     Elf32_Ehdr ehdr;
 
     if (!read(source, ehdr) || !IS_ELF(ehdr)) {
@@ -463,11 +467,11 @@ void ElfParser::doParse(QIODevice *source, core::image::Image *image, const LogT
 
     switch (ehdr.e_ident[EI_CLASS]) {
         case ELFCLASS32: {
-            ElfParserImpl<Elf32>(source, image, log).parse();
+            ElfParserImpl<Elf32>(source, image, log, mappedFile).parse();
             break;
         }
         case ELFCLASS64: {
-            ElfParserImpl<Elf64>(source, image, log).parse();
+            ElfParserImpl<Elf64>(source, image, log, mappedFile).parse();
             break;
         }
         default: {
@@ -43,7 +43,8 @@ public:
 
 protected:
     virtual bool doCanParse(QIODevice *source) const override;
-    virtual void doParse(QIODevice *source, core::image::Image *image, const LogToken &logToken) const override;
+    virtual void doParse(QIODevice *source, core::image::Image *image, const LogToken &logToken,
+                         const core::image::MappedFile *mappedFile) const override;
 };
 
 } // namespace elf
@@ -21,6 +21,7 @@ struct HeaderPos {
 };
 
 using nc::core::input::read;
+using nc::core::input::readBytes;
 using nc::core::input::ParseError;
 
 const ByteOrder bo = ByteOrder::LittleEndian;
@@ -181,7 +182,8 @@ bool LeParser::doCanParse(QIODevice *in) const {
     return bool(findHeaderPos(in));
 }
 
-void LeParser::doParse(QIODevice *in, core::image::Image *image, const LogToken &log) const {
+void LeParser::doParse(QIODevice *in, core::image::Image *image, const LogToken &log,
+                       const core::image::MappedFile *mappedFile) const {
     HeaderPos hpos = *findHeaderPos(in);
     le_header h;
     if (!in->seek(hpos.le) || !read(in, h)) {
@@ -229,9 +231,11 @@ void LeParser::doParse(QIODevice *in, core::image::Image *image, const LogToken
         if (oi == h.object_table_entries - 1) { // last object has last page
             len -= h.memory_page_size - h.bytes_on_last_page;
         }
-        if (!in->seek(off) || (bytes[oi] = in->read(len), bytes[oi].size() != len)) {
+        auto content = readBytes(in, mappedFile, off, len);
+        if (!content || content->size() != len) {
             throw ParseError(tr("Truncated object body at 0x%1:0x%2 for object %3").arg(off, 1, 16).arg(len, 1, 16).arg(oi));
         }
+        bytes[oi] = std::move(*content);
         log.debug(tr("Adding section %1 at 0x%2:0x%3").arg(section->name()).arg(off, 1, 16).arg(len, 1, 16));
         image->addSection(std::move(section));
         if (h.initial_object_CS_number - 1 == oi) {
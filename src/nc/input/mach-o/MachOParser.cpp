@@ -26,6 +26,7 @@ namespace mach_o {
 namespace {
 
 using nc::core::input::read;
+using nc::core::input::readBytes;
 using nc::core::input::getAsciizString;
 using nc::core::input::ParseError;
 
@@ -77,6 +78,7 @@ class MachOParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    const core::image::MappedFile *mappedFile_;
 
     ByteOrder byteOrder_;
     boost::unordered_map<const core::image::Section *, uint64_t> section2foff_;
@@ -85,8 +87,9 @@ class MachOParserImpl {
     std::vector<IndirectSection> indirectSections_;
 
 public:
-    MachOParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log):
-        source_(source), image_(image), log_(log), byteOrder_(ByteOrder::Current)
+    MachOParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log,
+                    const core::image::MappedFile *mappedFile):
+        source_(source), image_(image), log_(log), mappedFile_(mappedFile), byteOrder_(ByteOrder::Current)
     {}
 
     template<class Mach>
@@ -254,17 +257,15 @@ private:
         imageSection->setBss((section.flags & SECTION_TYPE) == S_ZEROFILL);
 
         if (!imageSection->isBss()) {
-            auto pos = source_->pos();
-            if (!source_->seek(section.offset)) {
+            auto bytes = readBytes(source_, mappedFile_, section.offset, section.size);
+            if (!bytes) {
                 throw ParseError("Could not seek to the beginning of the section's content.");
             }
-            auto bytes = source_->read(section.size);
-            if (checked_cast<uint32_t>(bytes.size()) != section.size) {
+            if (checked_cast<uint32_t>(bytes->size()) != section.size) {
                 log_.warning("Could not read all the section's content.");
             } else {
-                imageSection->setContent(std::move(bytes));
+                imageSection->setContent(std::move(*bytes));
             }
-            source_->seek(pos);
         }
 
         sections_.push_back(imageSection.get());
@@ -419,7 +420,8 @@ bool MachOParser::doCanParse(QIODevice *source) const {
     return read(source, magic) && getBitnessAndByteOrder(magic);
 }
 
-void MachOParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log) const {
+void MachOParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log,
+                          const core::image::MappedFile *mappedFile) const {
     uint32_t magic;
     if (!read(source, magic)) {
         throw ParseError(tr("Could not read Mach-O magic."));
@@ -432,10 +434,10 @@ void MachOParser::doParse(QIODevice *source, core::image::Image *image, const Lo
 
     switch (bitnessAndByteOrder->first) {
         case 32:
-            MachOParserImpl(source, image, log).parse<MachO32>();
+            MachOParserImpl(source, image, log, mappedFile).parse<MachO32>();
             break;
         case 64:
-            MachOParserImpl(source, image, log).parse<MachO64>();
+            MachOParserImpl(source, image, log, mappedFile).parse<MachO64>();
             break;
         default:
             unreachable();
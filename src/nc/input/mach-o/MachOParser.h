@@ -20,7 +20,8 @@ public:
 
 protected:
     virtual bool doCanParse(QIODevice *source) const override;
-    virtual void doParse(QIODevice *source, core::image::Image *image, const LogToken &log) const override;
+    virtual void doParse(QIODevice *source, core::image::Image *image, const LogToken &log,
+                         const core::image::MappedFile *mappedFile) const override;
 };
 
 } // namespace mach_o
@@ -50,6 +50,7 @@ namespace pe {
 namespace {
 
 using nc::core::input::read;
+using nc::core::input::readBytes;
 using nc::core::input::getAsciizString;
 using nc::core::input::ParseError;
 
@@ -112,14 +113,16 @@ class PeParserImpl {
     QIODevice *source_;
     core::image::Image *image_;
     const LogToken &log_;
+    const core::image::MappedFile *mappedFile_;
 
     ByteAddr optionalHeaderOffset_;
     IMAGE_FILE_HEADER &fileHeader_;
     IMAGE_OPTIONAL_HEADER optionalHeader_;
 
 public:
-    PeParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log, IMAGE_FILE_HEADER &fileHeader):
-        source_(source), image_(image), log_(log), fileHeader_(fileHeader)
+    PeParserImpl(QIODevice *source, core::image::Image *image, const LogToken &log,
+                 const core::image::MappedFile *mappedFile, IMAGE_FILE_HEADER &fileHeader):
+        source_(source), image_(image), log_(log), mappedFile_(mappedFile), fileHeader_(fileHeader)
     {}
 
     void parse() {
@@ -205,13 +208,11 @@ private:
 
                 QByteArray bytes;
 
-                auto pos = source_->pos();
-                if (source_->seek(sectionHeader.PointerToRawData)) {
-                    bytes = source_->read(sectionHeader.SizeOfRawData);
+                if (auto content = readBytes(source_, mappedFile_, sectionHeader.PointerToRawData, sectionHeader.SizeOfRawData)) {
+                    bytes = std::move(*content);
                 } else {
                     log_.warning(tr("Could not seek to the data of section %1.").arg(section->name()));
                 }
-                source_->seek(pos);
 
                 if (static_cast<DWORD>(bytes.size()) != sectionHeader.SizeOfRawData) {
                     log_.warning(tr("Could read only 0x%1 bytes of section %2, although its raw size is 0x%3.")
@@ -525,7 +526,8 @@ bool PeParser::doCanParse(QIODevice *source) const {
     return seekFileHeader(source);
 }
 
-void PeParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log) const {
+void PeParser::doParse(QIODevice *source, core::image::Image *image, const LogToken &log,
+                       const core::image::MappedFile *mappedFile) const {
     if (!seekFileHeader(source)) {
         throw ParseError(tr("PE signature doesn't match."));
     }
@@ -563,11 +565,11 @@ void PeParser::doParse(QIODevice *source, core::image::Image *image, const LogTo
     switch (optionalHeaderMagic) {
         case IMAGE_NT_OPTIONAL_HDR32_MAGIC:
             log.debug(tr("Parsing as a PE32 file."));
-            PeParserImpl<IMAGE_OPTIONAL_HEADER32, IMPORT_LOOKUP_TABLE_ENTRY32>(source, image, log, fileHeader).parse();
+            PeParserImpl<IMAGE_OPTIONAL_HEADER32, IMPORT_LOOKUP_TABLE_ENTRY32>(source, image, log, mappedFile, fileHeader).parse();
             break;
         case IMAGE_NT_OPTIONAL_HDR64_MAGIC:
             log.debug(("Parsing as a PE32+ file."));
-            PeParserImpl<IMAGE_OPTIONAL_HEADER64, IMPORT_LOOKUP_TABLE_ENTRY64>(source, image, log, fileHeader).parse();
+            PeParserImpl<IMAGE_OPTIONAL_HEADER64, IMPORT_LOOKUP_TABLE_ENTRY64>(source, image, log, mappedFile, fileHeader).parse();
             break;
         default:
             throw ParseError(tr("Unknown optional header magic: 0x%1").arg(optionalHeaderMagic, 0, 16));
@@ -25,9 +25,12 @@
 #include <nc/config.h>
 
 #include <nc/common/Branding.h>
+#include <nc/common/Escaping.h>
 #include <nc/common/Exception.h>
 #include <nc/common/Foreach.h>
+#include <nc/common/ParallelFor.h>
 #include <nc/common/StreamLogger.h>
+#include <nc/common/TaggingLogger.h>
 #include <nc/common/Unreachable.h>
 
 #include <nc/core/Context.h>
@@ -50,9 +53,14 @@
 #include <nc/core/likec/Tree.h>
 
 #include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
 #include <QFile>
+#include <QFileInfo>
+#include <QSet>
 #include <QStringList>
 #include <QTextStream>
+#include <QThread>
 
 #include <nc/core/image/Section.h>
 
@@ -130,6 +138,146 @@ void printRegionGraphs(nc::core::Context &context, QTextStream &out) {
     out << "}" << '\n';
 }
 
+/**
+ * Reads the list of inputs of a batch.
+ *
+ * \param path Path to a directory, whose files are the inputs, or to a manifest
+ *             file listing one input per line. Empty lines and lines starting
+ *             with '#' in the manifest are ignored. '-' stands for stdin.
+ *
+ * \return Paths to the inputs.
+ */
+QStringList readBatchInputs(const QString &path) {
+    QStringList result;
+
+    if (QFileInfo(path).isDir()) {
+        foreach (const QFileInfo &info, QDir(path).entryInfoList(QDir::Files, QDir::Name)) {
+            result.append(info.filePath());
+        }
+        return result;
+    }
+
+    auto readManifest = [&](QTextStream &in) {
+        while (!in.atEnd()) {
+            auto line = in.readLine().trimmed();
+            if (!line.isEmpty() && !line.startsWith('#')) {
+                result.append(line);
+            }
+        }
+    };
+
+    if (path == "-") {
+        readManifest(qin);
+    } else {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            throw nc::Exception(QString("could not open batch manifest: %1").arg(path));
+        }
+        QTextStream in(&file);
+        readManifest(in);
+    }
+
+    return result;
+}
+
+/**
+ * Decompiles every input in its own context and writes the C++ code to
+ * <outputDir>/<input file name>.cpp. At most batchJobs contexts exist at a time.
+ * A summary with a line per input is written to <outputDir>/summary.tsv.
+ * Backslashes, tabs and line breaks in its fields are escaped as in C.
+ *
+ * \param inputs    Paths to the inputs.
+ * \param outputDir Directory for the outputs.
+ * \param jobs      Number of threads used for analyzing functions of a single input.
+ * \param batchJobs Number of inputs decompiled concurrently.
+ * \param budget    Limits on the work spent on each function.
+ * \param logger    Logger shared by all the contexts. Can be nullptr.
+ *                  Messages and events of each context are tagged with its input.
+ *
+ * \return Number of inputs that failed to decompile.
+ */
+int decompileBatch(const QStringList &inputs, const QString &outputDir, int jobs, int batchJobs,
+                   const nc::Budget &budget, const std::shared_ptr<nc::Logger> &logger)
+{
+    if (!QDir().mkpath(outputDir)) {
+        throw nc::Exception(QString("could not create output directory: %1").arg(outputDir));
+    }
+
+    /* Give inputs having the same file name different outputs. */
+    QStringList outputs;
+    QSet<QString> usedNames;
+    foreach (const QString &input, inputs) {
+        auto name = QFileInfo(input).fileName();
+        auto uniqueName = name;
+        for (int i = 1; usedNames.contains(uniqueName); ++i) {
+            uniqueName = QString("%1.%2").arg(name).arg(i);
+        }
+        usedNames.insert(uniqueName);
+        outputs.append(QDir(outputDir).filePath(uniqueName + ".cpp"));
+    }
+
+    std::vector<QString> errors(inputs.size());
+    std::vector<qint64> durations(inputs.size());
+
+    QElapsedTimer totalTimer;
+    totalTimer.start();
+
+    nc::parallelFor(inputs.size(), batchJobs, [&](std::size_t i) {
+        QElapsedTimer timer;
+        timer.start();
+
+        nc::LogToken logToken;
+        if (logger) {
+            logToken = nc::LogToken(std::make_shared<nc::TaggingLogger>(logger, inputs[i]));
+        }
+
+        try {
+            nc::core::Context context;
+            context.setThreadCount(jobs);
+            context.setBudget(budget);
+            context.setLogToken(logToken);
+
+            nc::core::Driver::parse(context, inputs[i]);
+            nc::core::Driver::disassemble(context);
+            nc::core::Driver::decompile(context);
+
+            openFileForWritingAndCall(outputs[i], [&](QTextStream &out) { context.tree()->print(out); });
+        } catch (const nc::Exception &e) {
+            errors[i] = e.unicodeWhat();
+        } catch (const std::exception &e) {
+            errors[i] = QString::fromLocal8Bit(e.what());
+        }
+
+        durations[i] = timer.elapsed();
+
+        if (errors[i].isEmpty()) {
+            logToken.info(QString("done in %1 ms.").arg(durations[i]));
+        } else {
+            logToken.error(errors[i]);
+        }
+    });
+
+    int nfailed = 0;
+
+    openFileForWritingAndCall(QDir(outputDir).filePath("summary.tsv"), [&](QTextStream &out) {
+        out << "input\tstatus\tmilliseconds\toutput or error" << '\n';
+        for (int i = 0; i < inputs.size(); ++i) {
+            out << nc::escapeTsvString(inputs[i]);
+            if (errors[i].isEmpty()) {
+                out << "\tok\t" << durations[i] << '\t' << nc::escapeTsvString(outputs[i]) << '\n';
+            } else {
+                out << "\tfailed\t" << durations[i] << '\t' << nc::escapeTsvString(errors[i]) << '\n';
+                ++nfailed;
+            }
+        }
+    });
+
+    qerr << self << ": decompiled " << (inputs.size() - nfailed) << " of " << inputs.size()
+         << " inputs in " << totalTimer.elapsed() << " ms" << '\n';
+
+    return nfailed;
+}
+
 void help() {
     auto branding = nc::branding();
     branding.setApplicationName("Nocode");
@@ -139,6 +287,18 @@ void help() {
          << "Options:" << '\n'
          << "  --help, -h                  Produce this help message and quit." << '\n'
          << "  --verbose, -v               Print progress information to stderr." << '\n'
+         << "  --log-level=LEVEL           Print messages of at least the given level (debug, info, warning, error) to stderr." << '\n'
+         << "  --log-events                Print timings of analysis passes to stderr as tab-separated lines." << '\n'
+         << "                              Without --verbose or --log-level, no other messages are printed." << '\n'
+         << "  --jobs[=N], -j[N]           Analyze functions using N threads (default: number of CPUs)." << '\n'
+         << "  --function-time-limit=MS    Limit the time spent on a function in each analysis." << '\n'
+         << "  --function-iteration-limit=N Limit the number of iterations over a function in each analysis." << '\n'
+         << "  --function-size-limit=N     Analyze functions with more than N statements in a cheaper way." << '\n'
+         << "                              Functions exceeding a limit are decompiled partially." << '\n'
+         << "  --batch=PATH                Decompile each file listed in the manifest PATH (one per line)," << '\n'
+         << "                              or each file in the directory PATH, separately." << '\n'
+         << "  --batch-jobs=N              Decompile N files of the batch at a time (default: 1)." << '\n'
+         << "  --output-dir=DIR            Write C++ code of the batch and summary.tsv into DIR (default: .)." << '\n'
          << "  --print-sections[=FILE]     Print information about sections of the executable file." << '\n'
          << "  --print-symbols[=FILE]      Print the symbols from the executable file." << '\n'
          << "  --print-instructions[=FILE] Print parsed instructions to the file." << '\n'
@@ -187,6 +347,17 @@ int main(int argc, char *argv[]) {
 
         bool autoDefault = true;
         bool verbose = false;
+        nc::LogLevel logLevel = nc::LogLevel::LOWEST;
+        bool logEvents = false;
+        int jobs = 1;
+
+        QString batchPath;
+        QString outputDir = ".";
+        int batchJobs = 1;
+
+        qint64 functionTimeLimit = 0;
+        std::size_t functionIterationLimit = 0;
+        std::size_t functionSizeLimit = 0;
 
         std::vector<nc::ByteAddr> functionAddresses;
         std::vector<nc::ByteAddr> callAddresses;
@@ -202,6 +373,55 @@ int main(int argc, char *argv[]) {
                 return 1;
             } else if (arg == "--verbose" || arg == "-v") {
                 verbose = true;
+            } else if (arg.startsWith("--log-level=")) {
+                auto name = arg.section('=', 1);
+                if (name == "debug") {
+                    logLevel = nc::LogLevel::DEBUG;
+                } else if (name == "info") {
+                    logLevel = nc::LogLevel::INFO;
+                } else if (name == "warning") {
+                    logLevel = nc::LogLevel::WARNING;
+                } else if (name == "error") {
+                    logLevel = nc::LogLevel::ERROR;
+                } else {
+                    throw nc::Exception(QString("invalid log level: %1").arg(arg));
+                }
+                verbose = true;
+            } else if (arg == "--log-events") {
+                logEvents = true;
+            } else if (arg.startsWith("--batch=")) {
+                batchPath = arg.section('=', 1);
+            } else if (arg.startsWith("--batch-jobs=")) {
+                bool ok;
+                batchJobs = arg.section('=', 1).toInt(&ok);
+                if (!ok || batchJobs < 1) {
+                    throw nc::Exception(QString("invalid number of batch jobs: %1").arg(arg));
+                }
+            } else if (arg.startsWith("--output-dir=")) {
+                outputDir = arg.section('=', 1);
+            } else if (arg.startsWith("--function-time-limit=") ||
+                       arg.startsWith("--function-iteration-limit=") ||
+                       arg.startsWith("--function-size-limit=")) {
+                bool ok;
+                auto limit = arg.section('=', 1).toLongLong(&ok);
+                if (!ok || limit < 0) {
+                    throw nc::Exception(QString("invalid limit: %1").arg(arg));
+                }
+                if (arg.startsWith("--function-time-limit=")) {
+                    functionTimeLimit = limit;
+                } else if (arg.startsWith("--function-iteration-limit=")) {
+                    functionIterationLimit = limit;
+                } else {
+                    functionSizeLimit = limit;
+                }
+            } else if (arg == "--jobs" || arg == "-j") {
+                jobs = QThread::idealThreadCount();
+            } else if (arg.startsWith("--jobs=") || arg.startsWith("-j")) {
+                bool ok;
+                jobs = (arg.startsWith("-j") ? arg.mid(2) : arg.section('=', 1)).toInt(&ok);
+                if (!ok || jobs < 1) {
+                    throw nc::Exception(QString("invalid number of jobs: %1").arg(arg));
+                }
 
             #define FILE_OPTION(option, variable)       \
             } else if (arg == option) {                 \
@@ -244,15 +464,30 @@ int main(int argc, char *argv[]) {
             cxxFile = "-";
         }
 
+        std::shared_ptr<nc::Logger> logger;
+        if (verbose || logEvents) {
+            logger = std::make_shared<nc::StreamLogger>(qerr, logLevel, logEvents, verbose);
+        }
+        nc::LogToken logToken;
+        if (logger) {
+            logToken = nc::LogToken(logger);
+        }
+
+        nc::Budget budget(functionTimeLimit, functionIterationLimit, functionSizeLimit);
+
+        if (!batchPath.isEmpty()) {
+            files.append(readBatchInputs(batchPath));
+            return decompileBatch(files, outputDir, jobs, batchJobs, budget, logger) == 0 ? 0 : 1;
+        }
+
         if (files.empty()) {
             throw nc::Exception("no input files");
         }
 
         nc::core::Context context;
-
-        if (verbose) {
-            context.setLogToken(nc::LogToken(std::make_shared<nc::StreamLogger>(qerr)));
-        }
+        context.setThreadCount(jobs);
+        context.setBudget(budget);
+        context.setLogToken(logToken);
 
         foreach (const QString &filename, files) {
             try {